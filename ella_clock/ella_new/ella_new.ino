@@ -6,10 +6,13 @@
 // This allows the background to change independently of the digit rendering.
 // The hardware and display layout are the same as ella_clock:
 //   32×16 matrix, rows 0-9 for the clock, row 10 separator, rows 11-15 date.
+// Both buffers are sized from MATRIX_WIDTH × MATRIX_HEIGHT; the face stays in
+// the top-left 32×16 of a larger panel.
 
 #include <Adafruit_Protomatter.h>
 #include <Adafruit_GFX.h>
 #include "RTClib.h"
+#include "font_array.h"
 
 // Colour aliases
 #define RED   colors[0]
@@ -41,10 +44,15 @@ uint8_t latchPin   = 1;
 uint8_t oePin      = 0;
 int rot = 0;
 
-// Adafruit Protomatter matrix: 32 px wide, 4-bit colour depth, single chain,
-// 3 address pins (height inferred as 16), no double-buffering
+// Physical panel size in pixels (before rotation)
+#define MATRIX_WIDTH  32
+#define MATRIX_HEIGHT 16
+
+// Adafruit Protomatter matrix: MATRIX_WIDTH px wide, 4-bit colour depth,
+// single chain, 3 address pins (height inferred as 16; use 4 for
+// MATRIX_HEIGHT 32), no double-buffering
 Adafruit_Protomatter matrix(
-  32,          // Width of matrix in pixels
+  MATRIX_WIDTH, // Width of matrix in pixels
   4,           // Bit depth, 1-6
   1, rgbPins,  // # of matrix chains, RGB pins
   3, addrPins, // # of address pins, address pin array
@@ -69,13 +77,27 @@ uint16_t colors[] = {
 };
 
 // Two-layer pixel buffers (background and foreground colour maps)
-uint16_t base_pixels[16][32]; // background colour for each pixel
-uint16_t top_pixels[16][32];  // foreground colour used when drawing digit glyphs
+uint16_t base_pixels[MATRIX_HEIGHT][MATRIX_WIDTH]; // background colour for each pixel
+uint16_t top_pixels[MATRIX_HEIGHT][MATRIX_WIDTH];  // foreground colour used when drawing digit glyphs
+
+// framebuffer.h provides direct writes into the matrix canvas, bypassing
+// per-pixel drawPixel(); it must be included after matrix is declared.
+#include "framebuffer.h"
 
 // Real-time clock and current timestamp
 RTC_DS3231 rtc;
 DateTime now;
 
+// Count seconds from the DS3231 1 Hz square wave and read the RTC over I²C
+// only once per minute (1), or read it on every loop pass (0).
+// Wire the DS3231 INT/SQW pin to RTC_SQW_PIN; change the pin to match.
+#define ENABLE_SQW_CLOCK 1
+#define RTC_SQW_PIN      6
+
+#if ENABLE_SQW_CLOCK
+#include "sqw_clock.h"
+#endif
+
 // time_hhmm[0..3] = [H1, H2, M1, M2] as digit indices 0-9
 int time_hhmm[4] = {3, 1, 4, 1};
 
@@ -83,222 +105,83 @@ int time_hhmm[4] = {3, 1, 4, 1};
 int scroll = 0;
 
 // Month lookup table: each entry holds three letter indices (A=0 … Z=25)
-// for the 3-char month abbreviation shown in the date row
-int months[12][3] = {
+// for the 3-char month abbreviation shown in the date row.
+// The glyphs themselves live in font_array.h.
+const uint8_t months[12][3] = {
   {9,0,13}, {5,4,1}, {12,0,17}, {0,15,17}, {12,0,24}, {9,20,13},
   {9,20,11}, {0,20,6}, {18,4,15}, {14,2,19}, {13,14,21}, {3,4,2}
 };
 
-// Small 3×5 numeric glyphs (indices 0-9) stored as bool[5][3]
-bool small_num[10][5][3] = {
-  {{1,1,1},{1,0,1},{1,0,1},{1,0,1},{1,1,1}}, // 0
-  {{1,1,0},{0,1,0},{0,1,0},{0,1,0},{1,1,1}}, // 1
-  {{1,1,1},{0,0,1},{0,1,0},{1,0,0},{1,1,1}}, // 2
-  {{1,1,1},{0,0,1},{1,1,1},{0,0,1},{1,1,1}}, // 3
-  {{1,0,1},{1,0,1},{1,1,1},{0,0,1},{0,0,1}}, // 4
-  {{1,1,1},{1,0,0},{1,1,1},{0,0,1},{1,1,1}}, // 5
-  {{1,1,1},{1,0,0},{1,1,1},{1,0,1},{1,1,1}}, // 6
-  {{1,1,1},{0,0,1},{0,0,1},{0,0,1},{0,0,1}}, // 7
-  {{1,1,1},{1,0,1},{1,1,1},{1,0,1},{1,1,1}}, // 8
-  {{1,1,1},{1,0,1},{1,1,1},{0,0,1},{0,0,1}}  // 9
-};
-
-// Small 3×5 uppercase letter glyphs (A=0 … Z=25) stored as bool[5][3]
-bool letters[26][5][3] = {
-  {{1,1,1},{1,0,1},{1,1,1},{1,0,1},{1,0,1}}, // A
-  {{1,1,1},{1,0,1},{1,1,0},{1,0,1},{1,1,1}}, // B
-  {{1,1,1},{1,0,0},{1,0,0},{1,0,0},{1,1,1}}, // C
-  {{1,1,0},{1,0,1},{1,0,1},{1,0,1},{1,1,0}}, // D
-  {{1,1,1},{1,0,0},{1,1,1},{1,0,0},{1,1,1}}, // E
-  {{1,1,1},{1,0,0},{1,1,1},{1,0,0},{1,0,0}}, // F
-  {{1,1,1},{1,0,0},{1,0,1},{1,0,1},{1,1,1}}, // G
-  {{1,0,1},{1,0,1},{1,1,1},{1,0,1},{1,0,1}}, // H
-  {{1,1,1},{0,1,0},{0,1,0},{0,1,0},{1,1,1}}, // I
-  {{0,1,1},{0,0,1},{0,0,1},{1,0,1},{1,1,1}}, // J
-  {{1,0,1},{1,0,1},{1,1,0},{1,0,1},{1,0,1}}, // K
-  {{1,0,0},{1,0,0},{1,0,0},{1,0,0},{1,1,1}}, // L
-  {{1,0,1},{1,1,1},{1,0,1},{1,0,1},{1,0,1}}, // M
-  {{1,1,1},{1,0,1},{1,0,1},{1,0,1},{1,0,1}}, // N
-  {{1,1,1},{1,0,1},{1,0,1},{1,0,1},{1,1,1}}, // O
-  {{1,1,1},{1,0,1},{1,1,1},{1,0,0},{1,0,0}}, // P
-  {{1,1,1},{1,0,1},{1,0,1},{1,1,1},{0,0,1}}, // Q
-  {{1,1,1},{1,0,1},{1,1,0},{1,0,1},{1,0,1}}, // R
-  {{0,1,1},{1,0,0},{0,1,0},{0,0,1},{1,1,0}}, // S
-  {{1,1,1},{0,1,0},{0,1,0},{0,1,0},{0,1,0}}, // T
-  {{1,0,1},{1,0,1},{1,0,1},{1,0,1},{1,1,1}}, // U
-  {{1,0,1},{1,0,1},{1,0,1},{1,1,0},{1,0,0}}, // V
-  {{1,0,1},{1,0,1},{1,0,1},{1,1,1},{1,0,1}}, // W
-  {{1,0,1},{1,0,1},{0,1,0},{1,0,1},{1,0,1}}, // X
-  {{1,0,1},{1,0,1},{0,1,0},{0,1,0},{0,1,0}}, // Y
-  {{1,1,1},{0,0,1},{0,1,0},{1,0,0},{1,1,1}}  // Z
-};
+// ---- RAINBOW RING ----------------------------------------------------------
+// The diagonal rainbow colours pixel (x, y) with ring[(x + y + phase) % N].
+// rainbow_strip[] holds the ring repeated out to one row plus N - 1 entries,
+// so the row for any offset k is the MATRIX_WIDTH entries starting at
+// rainbow_strip[k]:
+// every phase/row combination is one precomputed row template.
 
-// 8×10 digit bitmaps (0-9) stored as bool[10][8]
-bool num[10][10][8] = {
-  // 0
-  {{0,0,1,1,1,0,0,0},{0,1,1,0,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
-   {1,1,0,1,0,1,1,0},{1,1,0,1,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
-   {0,1,1,0,1,1,0,0},{0,0,1,1,1,0,0,0}},
-  // 1
-  {{0,0,0,1,1,0,0,0},{0,0,1,1,1,0,0,0},{0,1,1,1,1,0,0,0},{0,0,0,1,1,0,0,0},
-   {0,0,0,1,1,0,0,0},{0,0,0,1,1,0,0,0},{0,0,0,1,1,0,0,0},{0,0,0,1,1,0,0,0},
-   {0,0,0,1,1,0,0,0},{0,1,1,1,1,1,1,0}},
-  // 2
-  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,1,1,0,0},
-   {0,0,0,1,1,0,0,0},{0,0,1,1,0,0,0,0},{0,1,1,0,0,0,0,0},{1,1,0,0,0,0,0,0},
-   {1,1,0,0,0,1,1,0},{1,1,1,1,1,1,1,0}},
-  // 3
-  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
-   {0,0,1,1,1,1,0,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
-   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
-  // 4
-  {{0,0,0,0,1,1,0,0},{0,0,0,1,1,1,0,0},{0,0,1,1,1,1,0,0},{0,1,1,0,1,1,0,0},
-   {1,1,0,0,1,1,0,0},{1,1,1,1,1,1,1,0},{0,0,0,0,1,1,0,0},{0,0,0,0,1,1,0,0},
-   {0,0,0,0,1,1,0,0},{0,0,0,1,1,1,1,0}},
-  // 5
-  {{1,1,1,1,1,1,1,0},{1,1,0,0,0,0,0,0},{1,1,0,0,0,0,0,0},{1,1,0,0,0,0,0,0},
-   {1,1,1,1,1,1,0,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
-   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
-  // 6
-  {{0,0,1,1,1,0,0,0},{0,1,1,0,0,0,0,0},{1,1,0,0,0,0,0,0},{1,1,0,0,0,0,0,0},
-   {1,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
-   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
-  // 7
-  {{1,1,1,1,1,1,1,0},{1,1,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
-   {0,0,0,0,1,1,0,0},{0,0,0,1,1,0,0,0},{0,0,1,1,0,0,0,0},{0,0,1,1,0,0,0,0},
-   {0,0,1,1,0,0,0,0},{0,0,1,1,0,0,0,0}},
-  // 8
-  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
-   {0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
-   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
-  // 9
-  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
-   {0,1,1,1,1,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
-   {0,0,0,0,1,1,0,0},{0,1,1,1,1,0,0,0}}
-};
+#define RAINBOW_N 6
 
-// Colon separator glyph: 2 wide × 10 tall (two dots at rows 2-3 and 6-7)
-bool colon_array[] = {
-  0,0,
-  0,0,
-  1,1,
-  1,1,
-  0,0,
-  0,0,
-  1,1,
-  1,1,
-  0,0,
-  0,0
-};
+uint16_t rainbow_strip[MATRIX_WIDTH + RAINBOW_N - 1];
 
-// ---- LINKED-LIST RAINBOW CYCLE ---------------------------------------------
-// A circular doubly-linked list of 6 colour nodes for smooth rainbow animation
-
-typedef struct link {
-  link* next;
-  link* past;
-  uint16_t color;
-} link;
-
-link* current = (link*) malloc(sizeof(link) * 1);
-link* head = current;
-link* minus_one = NULL;
-
-// Pre-declared array of pointers into the rainbow ring (populated by rainbow_link_setup)
-link* rainbow_link_array[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
-
-// Build the 6-node circular linked list for the rainbow colours
-void rainbow_link_setup() {
-  for (int i = 0; i < 5; i++) {
-    current->next = (link*) malloc(sizeof(link) * 1);
-    current->color = colors[i];
-    minus_one = current;
-    current = current->next;
-    current->past = minus_one;
-  }
-  current->color = colors[5];
-  current->next = head;
-  head->past = current;
-
-  // Populate the shortcut pointer array
-  rainbow_link_array[0] = head;
-  link* tmp = head;
-  for (int i = 1; i < 6; i++) {
-    tmp = tmp->next;
-    rainbow_link_array[i] = tmp;
+// Fill rainbow_strip from the first RAINBOW_N entries of colors[]
+void rainbow_setup() {
+  for (int i = 0; i < MATRIX_WIDTH + RAINBOW_N - 1; i++) {
+    rainbow_strip[i] = colors[i % RAINBOW_N];
   }
 }
 
 // ---- BACKGROUND PATTERN FUNCTIONS -----------------------------------------
 
-// Fill base_pixels with a diagonal rainbow pattern shifted by start (0-5)
+// Fill base_pixels with a diagonal rainbow pattern shifted by start (0-5):
+// one row-template copy per row, each row one step further round the ring.
 void diagonal_rainbow(int start) {
-  link* lo_current = rainbow_link_array[start % 6];
-  for (int y = 0; y < 16; y++) {
-    for (int x = 0; x < 32; x++) {
-      base_pixels[y][x] = lo_current->color;
-      lo_current = lo_current->next;
-    }
-    lo_current = lo_current->past; // correct for row-length not being a multiple of 6
+  int k = start % RAINBOW_N;
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    memcpy(base_pixels[y], &rainbow_strip[k], sizeof(base_pixels[y]));
+    if (++k == RAINBOW_N) { k = 0; }
   }
 }
 
 // Fill base_pixels with a 4-column red/blue/yellow/white pattern
 void RBYW() {
+  const int q = MATRIX_WIDTH / 4;
   for (int y = 0; y < 10; y++) {
-    for (int x = 0; x < 32; x++) {
-      base_pixels[y][x] = (x < 8) ? RED : (x < 16) ? BLUE : (x < 24) ? YELLOW : WHITE;
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      base_pixels[y][x] = (x < q) ? RED : (x < 2 * q) ? BLUE : (x < 3 * q) ? YELLOW : WHITE;
     }
   }
 }
 
 // Fill base_pixels with a Duke blue/white horizontal checker pattern
 void duke_checker() {
-  for (int x = 0; x < 32; x++) {
-    bool vert[] = {0,0,1,1,0,0,1,1,0,0,1,1,0,0,1,1};
-    for (int y = 0; y < 16; y++) {
-      base_pixels[y][x] = vert[y] ? DUKE_BLUE : WHITE;
+  for (int x = 0; x < MATRIX_WIDTH; x++) {
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+      base_pixels[y][x] = (y & 2) ? DUKE_BLUE : WHITE; // two rows white, two blue
     }
   }
 }
 
 // ---- PIXEL BUFFER HELPERS --------------------------------------------------
 
-// Draw base_pixels to the matrix (background layer)
+// Draw base_pixels to the matrix (background layer) in one bulk copy
 void refill_base() {
-  for (int x = 0; x < 32; x++) {
-    for (int y = 0; y < 16; y++) {
-      matrix.drawPixel(x, y, base_pixels[y][x]);
-    }
-  }
+  fb_copy_frame(base_pixels);
 }
 
 // ---- GLYPH DRAWING FUNCTIONS -----------------------------------------------
 
+// glyph.h provides drawGlyph<W,H>(), which colours each lit pixel from
+// top_pixels; it must be included after matrix and the pixel buffers.
+#include "glyph.h"
+
 // Draw an 8×10 digit glyph at column start_x using top_pixels for colour.
-// Fixed: original code had `x < start_x + 8` which accessed out-of-bounds
-// elements of num[value][y] (only 8 columns wide) when start_x > 0.
 void draw_digit(int start_x, int value) {
-  for (int y = 0; y < 10; y++) {
-    for (int x = 0; x < 8; x++) { // 8 columns per glyph
-      if (num[value][y][x]) {
-        matrix.drawPixel(x + start_x, y, top_pixels[y][x + start_x]);
-      }
-    }
-  }
+  drawGlyph<8, 10>(start_x, 0, num_rows[value], top_pixels);
 }
 
 // Draw a 3×5 small glyph (letter or digit) at (start_x, start_y) using top_pixels
 void draw_small(int start_x, int start_y, int value, bool letter) {
-  bool condition;
-  for (int y = 0; y < 5; y++) {
-    for (int x = 0; x < 3; x++) {
-      condition = letter ? letters[value][y][x] : small_num[value][y][x];
-      if (condition) {
-        matrix.drawPixel(x + start_x, y + start_y, top_pixels[y + start_y][x + start_x]);
-      }
-    }
-  }
+  drawGlyph<3, 5>(start_x, start_y, letter ? letter_rows[value] : small_num_rows[value], top_pixels);
 }
 
 // Draw the date in the bottom rows:
@@ -308,7 +191,7 @@ void draw_small(int start_x, int start_y, int value, bool letter) {
 // Fixed: original code had `{day%10, day-day%10}` which produced
 // the ones digit then a multiple-of-10 (e.g. 20) rather than the
 // two individual digits in the correct tens/ones order.
-void draw_date(int start_x, int month[3], int day) {
+void draw_date(int start_x, const uint8_t month[3], int day) {
   // tens digit first, then ones digit
   int date[5] = {month[0], month[1], month[2], day / 10, day % 10};
   draw_small(start_x,      11, date[0], true);  // month letter 1
@@ -318,19 +201,6 @@ void draw_date(int start_x, int month[3], int day) {
   draw_small(start_x + 16, 11, date[4], false); // day ones digit
 }
 
-// Draw an arbitrary boolean bitmap at (start_x, start_y) using top_pixels
-void draw_array(uint8_t start_x, uint8_t start_y, bool value[], uint8_t wide, uint8_t tall) {
-  int coord = 0;
-  for (int y = 0; y < tall; y++) {
-    for (int x = 0; x < wide; x++) {
-      if (value[coord]) {
-        matrix.drawPixel(x + start_x, y + start_y, top_pixels[y + start_y][x + start_x]);
-      }
-      coord++;
-    }
-  }
-}
-
 // ---- SETUP -----------------------------------------------------------------
 
 void setup() {
@@ -338,7 +208,11 @@ void setup() {
 
   rtc.begin();
   delay(100);
+#if ENABLE_SQW_CLOCK
+  now = sqw_begin();
+#else
   now = rtc.now();
+#endif
 
   // Initialise the Protomatter matrix
   ProtomatterStatus status = matrix.begin();
@@ -350,15 +224,15 @@ void setup() {
     for (;;); // halt on error
   }
 
-  // Build the rainbow colour ring used by diagonal_rainbow()
-  rainbow_link_setup();
+  // Build the rainbow row templates used by diagonal_rainbow()
+  rainbow_setup();
 
   // Seed the initial background with the diagonal rainbow pattern
   diagonal_rainbow(0);
 
   // Set all top_pixels to white so digits appear white over the rainbow
-  for (int y = 0; y < 16; y++) {
-    for (int x = 0; x < 32; x++) {
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
       top_pixels[y][x] = 65535; // white
     }
   }
@@ -367,7 +241,12 @@ void setup() {
 // ---- LOOP ------------------------------------------------------------------
 
 void loop() {
+#if ENABLE_SQW_CLOCK
+  // Only touch the I²C bus when the SQW count says the minute rolled over.
+  if (sqw_poll()) { now = sqw_resync(); }
+#else
   now = rtc.now();
+#endif
 
   // Update time_hhmm[] from current RTC reading
   if (now.twelveHour() < 10) { time_hhmm[0] = 0; time_hhmm[1] = now.twelveHour(); }
@@ -387,10 +266,10 @@ void loop() {
   }
 
   // Draw colon separator (2 px wide, 10 px tall, centred between columns 1 and 2)
-  draw_array(15, 0, colon_array, 2, 10);
+  drawGlyph<2, 10>(15, 0, colon_rows, top_pixels);
 
   // Draw a black separator line between the time and date areas
-  matrix.drawFastHLine(0, 10, 32, 0);
+  matrix.drawFastHLine(0, 10, MATRIX_WIDTH, 0);
 
   // Draw the date in the bottom rows using the top_pixels colour (white)
   draw_date(10, months[now.month() - 1], now.day());
@@ -0,0 +1,159 @@
+// font_array.h
+// Glyph tables for ella_new.
+// The bool tables below are the editable source for every glyph.  They are
+// constexpr, so they never occupy RAM: the drawing code only reads the
+// bit-packed *_rows tables at the bottom of this file, which are generated
+// from them at compile time and stored in flash.
+
+// Small 3×5 numeric glyphs (indices 0-9) stored as bool[5][3]
+constexpr bool small_num[10][5][3] = {
+  {{1,1,1},{1,0,1},{1,0,1},{1,0,1},{1,1,1}}, // 0
+  {{1,1,0},{0,1,0},{0,1,0},{0,1,0},{1,1,1}}, // 1
+  {{1,1,1},{0,0,1},{0,1,0},{1,0,0},{1,1,1}}, // 2
+  {{1,1,1},{0,0,1},{1,1,1},{0,0,1},{1,1,1}}, // 3
+  {{1,0,1},{1,0,1},{1,1,1},{0,0,1},{0,0,1}}, // 4
+  {{1,1,1},{1,0,0},{1,1,1},{0,0,1},{1,1,1}}, // 5
+  {{1,1,1},{1,0,0},{1,1,1},{1,0,1},{1,1,1}}, // 6
+  {{1,1,1},{0,0,1},{0,0,1},{0,0,1},{0,0,1}}, // 7
+  {{1,1,1},{1,0,1},{1,1,1},{1,0,1},{1,1,1}}, // 8
+  {{1,1,1},{1,0,1},{1,1,1},{0,0,1},{0,0,1}}  // 9
+};
+
+// Small 3×5 uppercase letter glyphs (A=0 … Z=25) stored as bool[5][3]
+constexpr bool letters[26][5][3] = {
+  {{1,1,1},{1,0,1},{1,1,1},{1,0,1},{1,0,1}}, // A
+  {{1,1,1},{1,0,1},{1,1,0},{1,0,1},{1,1,1}}, // B
+  {{1,1,1},{1,0,0},{1,0,0},{1,0,0},{1,1,1}}, // C
+  {{1,1,0},{1,0,1},{1,0,1},{1,0,1},{1,1,0}}, // D
+  {{1,1,1},{1,0,0},{1,1,1},{1,0,0},{1,1,1}}, // E
+  {{1,1,1},{1,0,0},{1,1,1},{1,0,0},{1,0,0}}, // F
+  {{1,1,1},{1,0,0},{1,0,1},{1,0,1},{1,1,1}}, // G
+  {{1,0,1},{1,0,1},{1,1,1},{1,0,1},{1,0,1}}, // H
+  {{1,1,1},{0,1,0},{0,1,0},{0,1,0},{1,1,1}}, // I
+  {{0,1,1},{0,0,1},{0,0,1},{1,0,1},{1,1,1}}, // J
+  {{1,0,1},{1,0,1},{1,1,0},{1,0,1},{1,0,1}}, // K
+  {{1,0,0},{1,0,0},{1,0,0},{1,0,0},{1,1,1}}, // L
+  {{1,0,1},{1,1,1},{1,0,1},{1,0,1},{1,0,1}}, // M
+  {{1,1,1},{1,0,1},{1,0,1},{1,0,1},{1,0,1}}, // N
+  {{1,1,1},{1,0,1},{1,0,1},{1,0,1},{1,1,1}}, // O
+  {{1,1,1},{1,0,1},{1,1,1},{1,0,0},{1,0,0}}, // P
+  {{1,1,1},{1,0,1},{1,0,1},{1,1,1},{0,0,1}}, // Q
+  {{1,1,1},{1,0,1},{1,1,0},{1,0,1},{1,0,1}}, // R
+  {{0,1,1},{1,0,0},{0,1,0},{0,0,1},{1,1,0}}, // S
+  {{1,1,1},{0,1,0},{0,1,0},{0,1,0},{0,1,0}}, // T
+  {{1,0,1},{1,0,1},{1,0,1},{1,0,1},{1,1,1}}, // U
+  {{1,0,1},{1,0,1},{1,0,1},{1,1,0},{1,0,0}}, // V
+  {{1,0,1},{1,0,1},{1,0,1},{1,1,1},{1,0,1}}, // W
+  {{1,0,1},{1,0,1},{0,1,0},{1,0,1},{1,0,1}}, // X
+  {{1,0,1},{1,0,1},{0,1,0},{0,1,0},{0,1,0}}, // Y
+  {{1,1,1},{0,0,1},{0,1,0},{1,0,0},{1,1,1}}  // Z
+};
+
+// 8×10 digit bitmaps (0-9) stored as bool[10][8]
+constexpr bool num[10][10][8] = {
+  // 0
+  {{0,0,1,1,1,0,0,0},{0,1,1,0,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
+   {1,1,0,1,0,1,1,0},{1,1,0,1,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
+   {0,1,1,0,1,1,0,0},{0,0,1,1,1,0,0,0}},
+  // 1
+  {{0,0,0,1,1,0,0,0},{0,0,1,1,1,0,0,0},{0,1,1,1,1,0,0,0},{0,0,0,1,1,0,0,0},
+   {0,0,0,1,1,0,0,0},{0,0,0,1,1,0,0,0},{0,0,0,1,1,0,0,0},{0,0,0,1,1,0,0,0},
+   {0,0,0,1,1,0,0,0},{0,1,1,1,1,1,1,0}},
+  // 2
+  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,1,1,0,0},
+   {0,0,0,1,1,0,0,0},{0,0,1,1,0,0,0,0},{0,1,1,0,0,0,0,0},{1,1,0,0,0,0,0,0},
+   {1,1,0,0,0,1,1,0},{1,1,1,1,1,1,1,0}},
+  // 3
+  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
+   {0,0,1,1,1,1,0,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
+   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
+  // 4
+  {{0,0,0,0,1,1,0,0},{0,0,0,1,1,1,0,0},{0,0,1,1,1,1,0,0},{0,1,1,0,1,1,0,0},
+   {1,1,0,0,1,1,0,0},{1,1,1,1,1,1,1,0},{0,0,0,0,1,1,0,0},{0,0,0,0,1,1,0,0},
+   {0,0,0,0,1,1,0,0},{0,0,0,1,1,1,1,0}},
+  // 5
+  {{1,1,1,1,1,1,1,0},{1,1,0,0,0,0,0,0},{1,1,0,0,0,0,0,0},{1,1,0,0,0,0,0,0},
+   {1,1,1,1,1,1,0,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
+   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
+  // 6
+  {{0,0,1,1,1,0,0,0},{0,1,1,0,0,0,0,0},{1,1,0,0,0,0,0,0},{1,1,0,0,0,0,0,0},
+   {1,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
+   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
+  // 7
+  {{1,1,1,1,1,1,1,0},{1,1,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
+   {0,0,0,0,1,1,0,0},{0,0,0,1,1,0,0,0},{0,0,1,1,0,0,0,0},{0,0,1,1,0,0,0,0},
+   {0,0,1,1,0,0,0,0},{0,0,1,1,0,0,0,0}},
+  // 8
+  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
+   {0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
+   {1,1,0,0,0,1,1,0},{0,1,1,1,1,1,0,0}},
+  // 9
+  {{0,1,1,1,1,1,0,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},{1,1,0,0,0,1,1,0},
+   {0,1,1,1,1,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},{0,0,0,0,0,1,1,0},
+   {0,0,0,0,1,1,0,0},{0,1,1,1,1,0,0,0}}
+};
+
+// Colon separator glyph: 2 wide × 10 tall (two dots at rows 2-3 and 6-7)
+constexpr bool colon_array[10][2] = {
+  {0,0},
+  {0,0},
+  {1,1},
+  {1,1},
+  {0,0},
+  {0,0},
+  {1,1},
+  {1,1},
+  {0,0},
+  {0,0}
+};
+
+// ---- BIT-PACKED GLYPH ROWS -------------------------------------------------
+// One bitmask per glyph row, most-significant used bit = leftmost column.
+
+// Pack w bool pixels starting at px into a row bitmask.
+constexpr uint8_t pack_row(const bool *px, int w) {
+  return w == 0 ? 0 : (uint8_t)((px[0] ? 1 << (w - 1) : 0) | pack_row(px + 1, w - 1));
+}
+
+#define NUM_ROWS(g)      { pack_row(num[g][0], 8), pack_row(num[g][1], 8), pack_row(num[g][2], 8), \
+                           pack_row(num[g][3], 8), pack_row(num[g][4], 8), pack_row(num[g][5], 8), \
+                           pack_row(num[g][6], 8), pack_row(num[g][7], 8), pack_row(num[g][8], 8), \
+                           pack_row(num[g][9], 8) }
+#define SMALL_ROWS(t, g) { pack_row(t[g][0], 3), pack_row(t[g][1], 3), pack_row(t[g][2], 3), \
+                           pack_row(t[g][3], 3), pack_row(t[g][4], 3) }
+
+// 8×10 digits 0-9: num_rows[digit][row]
+const uint8_t num_rows[10][10] = {
+  NUM_ROWS(0), NUM_ROWS(1), NUM_ROWS(2), NUM_ROWS(3), NUM_ROWS(4),
+  NUM_ROWS(5), NUM_ROWS(6), NUM_ROWS(7), NUM_ROWS(8), NUM_ROWS(9)
+};
+
+// 3×5 digits 0-9: small_num_rows[digit][row]
+const uint8_t small_num_rows[10][5] = {
+  SMALL_ROWS(small_num, 0), SMALL_ROWS(small_num, 1), SMALL_ROWS(small_num, 2),
+  SMALL_ROWS(small_num, 3), SMALL_ROWS(small_num, 4), SMALL_ROWS(small_num, 5),
+  SMALL_ROWS(small_num, 6), SMALL_ROWS(small_num, 7), SMALL_ROWS(small_num, 8),
+  SMALL_ROWS(small_num, 9)
+};
+
+// 3×5 letters A-Z: letter_rows[letter][row]
+const uint8_t letter_rows[26][5] = {
+  SMALL_ROWS(letters, 0),  SMALL_ROWS(letters, 1),  SMALL_ROWS(letters, 2),  SMALL_ROWS(letters, 3),
+  SMALL_ROWS(letters, 4),  SMALL_ROWS(letters, 5),  SMALL_ROWS(letters, 6),  SMALL_ROWS(letters, 7),
+  SMALL_ROWS(letters, 8),  SMALL_ROWS(letters, 9),  SMALL_ROWS(letters, 10), SMALL_ROWS(letters, 11),
+  SMALL_ROWS(letters, 12), SMALL_ROWS(letters, 13), SMALL_ROWS(letters, 14), SMALL_ROWS(letters, 15),
+  SMALL_ROWS(letters, 16), SMALL_ROWS(letters, 17), SMALL_ROWS(letters, 18), SMALL_ROWS(letters, 19),
+  SMALL_ROWS(letters, 20), SMALL_ROWS(letters, 21), SMALL_ROWS(letters, 22), SMALL_ROWS(letters, 23),
+  SMALL_ROWS(letters, 24), SMALL_ROWS(letters, 25)
+};
+
+// 2×10 colon separator
+const uint8_t colon_rows[10] = {
+  pack_row(colon_array[0], 2), pack_row(colon_array[1], 2), pack_row(colon_array[2], 2),
+  pack_row(colon_array[3], 2), pack_row(colon_array[4], 2), pack_row(colon_array[5], 2),
+  pack_row(colon_array[6], 2), pack_row(colon_array[7], 2), pack_row(colon_array[8], 2),
+  pack_row(colon_array[9], 2)
+};
+
+#undef NUM_ROWS
+#undef SMALL_ROWS
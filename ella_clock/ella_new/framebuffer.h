@@ -0,0 +1,65 @@
+// framebuffer.h
+// Direct access to the Protomatter canvas (GFXcanvas16::getBuffer()) for the
+// hot drawing paths, bypassing the per-pixel virtual drawPixel() call with
+// its rotation transform and bounds checks.
+// This file is #included inside ella_new.ino after the matrix object is
+// declared.
+//
+// The canvas is stored unrotated, MATRIX_WIDTH × MATRIX_HEIGHT, row-major.
+// A blit resolves the display rotation once into a starting index plus the
+// raw-buffer strides for one logical step right (step_x) and down (step_y).
+
+struct FbCursor {
+  int32_t origin;  // raw buffer index of logical (x, y)
+  int16_t step_x;  // raw index delta for x + 1
+  int16_t step_y;  // raw index delta for y + 1
+};
+
+// Map logical (x, y) under the current rotation to a raw-buffer cursor.
+// (x, y) itself may lie off the panel; callers clip before writing.
+FbCursor fb_cursor(int16_t x, int16_t y) {
+  const int16_t W = MATRIX_WIDTH, H = MATRIX_HEIGHT;
+  FbCursor c;
+  switch (matrix.getRotation()) {
+    case 1:  c.origin = (int32_t)x * W + (W - 1 - y);           c.step_x =  W; c.step_y = -1; break;
+    case 2:  c.origin = (int32_t)(H - 1 - y) * W + (W - 1 - x); c.step_x = -1; c.step_y = -W; break;
+    case 3:  c.origin = (int32_t)(H - 1 - x) * W + y;           c.step_x = -W; c.step_y =  1; break;
+    default: c.origin = (int32_t)y * W + x;                     c.step_x =  1; c.step_y =  W; break;
+  }
+  return c;
+}
+
+// Bitmask of the columns of a w-wide blit at x that land on the panel,
+// in glyph row order (most-significant used bit = leftmost column).
+uint16_t fb_clip_cols(int16_t x, uint8_t w) {
+  uint16_t mask = (1 << w) - 1;
+  if (x < 0)                     { mask = (-x >= w) ? 0 : mask & ((1 << (w + x)) - 1); }
+  if (x + w > matrix.width())    { int16_t cut = x + w - matrix.width();
+                                   mask = (cut >= w) ? 0 : mask & ~((1 << cut) - 1); }
+  return mask;
+}
+
+// Copy a whole logical frame (rows × columns in display orientation, e.g.
+// base_pixels) into the canvas.  Rotation 0 is a straight memcpy and rotation 2 a single
+// reversed linear pass; quarter turns fall back to cursor stepping.
+void fb_copy_frame(const uint16_t src[MATRIX_HEIGHT][MATRIX_WIDTH]) {
+  uint16_t *buf = matrix.getBuffer();
+  const uint16_t *in = &src[0][0];
+  const uint16_t n = MATRIX_WIDTH * MATRIX_HEIGHT;
+  switch (matrix.getRotation()) {
+    case 0:
+      memcpy(buf, in, n * sizeof(uint16_t));
+      break;
+    case 2:
+      for (uint16_t i = 0; i < n; i++) { buf[n - 1 - i] = in[i]; }
+      break;
+    default:
+      for (int16_t y = 0; y < matrix.height() && y < MATRIX_HEIGHT; y++) {
+        FbCursor c = fb_cursor(0, y);
+        for (int16_t x = 0; x < matrix.width() && x < MATRIX_WIDTH; x++, c.origin += c.step_x) {
+          buf[c.origin] = src[y][x];
+        }
+      }
+      break;
+  }
+}
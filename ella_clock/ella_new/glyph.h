@@ -0,0 +1,25 @@
+// glyph.h
+// Generic blitter for the bit-packed glyph tables in font_array.h.
+// This file is #included inside ella_new.ino after framebuffer.h and the
+// pixel buffers, and writes straight into the matrix canvas.
+
+// Draw a W-wide, H-tall glyph with its top-left corner at (x, y).  Each lit
+// pixel takes its colour from the same position in the ink layer (normally
+// top_pixels), so the text can be tinted per pixel.
+//   rows — H row bitmasks, most-significant used bit = leftmost column
+// Clipping and rotation are resolved once per glyph, not per pixel.
+template <uint8_t W, uint8_t H>
+void drawGlyph(int16_t x, int16_t y, const uint8_t *rows, const uint16_t ink[MATRIX_HEIGHT][MATRIX_WIDTH]) {
+  const uint8_t cols = fb_clip_cols(x, W);
+  if (!cols) { return; }
+  uint16_t *buf = matrix.getBuffer();
+  FbCursor c = fb_cursor(x + W - 1, y); // start at the rightmost column: bit 0
+  for (uint8_t r = 0; r < H; r++, c.origin += c.step_y) {
+    if (y + r < 0 || y + r >= matrix.height()) { continue; }
+    uint8_t bits = rows[r] & cols;
+    int16_t col = x + W - 1;
+    for (int32_t i = c.origin; bits; i -= c.step_x, col--, bits >>= 1) {
+      if (bits & 1) { buf[i] = ink[y + r][col]; }
+    }
+  }
+}
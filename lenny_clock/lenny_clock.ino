@@ -29,6 +29,16 @@
 RTC_DS3231 rtc;
 DateTime now;
 
+// Count seconds from the DS3231 1 Hz square wave and read the RTC over I²C
+// only once per minute (1), or read it on every loop pass (0).
+// Wire the DS3231 INT/SQW pin to RTC_SQW_PIN.
+#define ENABLE_SQW_CLOCK 1
+#define RTC_SQW_PIN      4
+
+#if ENABLE_SQW_CLOCK
+#include "sqw_clock.h"
+#endif
+
 // Adafruit Protomatter matrix: 32 px wide, 4-bit colour depth, single chain,
 // 3 address pins (height inferred as 16), no double-buffering
 Adafruit_Protomatter matrix(
@@ -46,14 +56,20 @@ matrix.color565(51, 254, 0), matrix.color565(0, 151, 253), matrix.color565(102,
 uint16_t duke[] = {matrix.color565(28, 33, 168), 65535, matrix.color565(72, 72, 72)};
 uint16_t yelp[] = {pride[5],0};
 
-// Scale all palette colours by a brightness factor (0.0 = off, 1.0 = full)
-void update_brightness(float br){
-  uint16_t pride2[] = {matrix.color565(253*br,0,0), matrix.color565(253*br, 152*br, 0), matrix.color565(254*br, 254*br, 0),
-    matrix.color565(51*br, 254*br, 0), matrix.color565(0, 151*br, 253*br), matrix.color565(102*br, 51*br, 253*br), 0};
-  for(int i =0; i<6;i++){pride[i] = pride2[i];}
-  duke[0] = matrix.color565(28*br, 33*br, 168*br);
-  duke[1] = matrix.color565(255*br, 255*br, 255*br);
-  duke[2] = matrix.color565(72*br, 72*br, 72*br);
+// color_lut.h provides the integer brightness/gamma table used below;
+// it must be included after matrix is declared.
+#include "color_lut.h"
+
+// Full-brightness RGB of the pride colours, rescaled by update_brightness()
+const uint8_t pride_rgb[6][3] = {{253,0,0}, {253,152,0}, {254,254,0}, {51,254,0}, {0,151,253}, {102,51,253}};
+
+// Scale all palette colours to a brightness level (0 = off, 255 = full)
+void update_brightness(uint8_t level){
+  set_brightness_level(level);
+  for(int i =0; i<6;i++){pride[i] = lut565(pride_rgb[i][0], pride_rgb[i][1], pride_rgb[i][2]);}
+  duke[0] = lut565(28, 33, 168);
+  duke[1] = lut565(255, 255, 255);
+  duke[2] = lut565(72, 72, 72);
   yelp[0] = pride[5];
 }
 
@@ -107,8 +123,13 @@ int trans_y_smol(int pos){
 int digits[] = {1,0,2,3};
 
 // Read the RTC and update the digits[] array with the current 12-hour time
+// (with ENABLE_SQW_CLOCK, the RTC is read only when the minute rolled over)
 void update_digits(){
+#if ENABLE_SQW_CLOCK
+  if(sqw_poll()){now = sqw_resync();}
+#else
   now = rtc.now();
+#endif
   if(now.twelveHour() < 10){digits[1] = now.twelveHour(); digits[0] = 0;}
   else{digits[0] = 1; digits[1] = now.twelveHour()-10;}
   digits[2] = (now.minute() / 10);
@@ -251,7 +272,11 @@ void setup(void) {
   rtc.begin();
 
   delay(100);
+#if ENABLE_SQW_CLOCK
+  now = sqw_begin();
+#else
   now = rtc.now();
+#endif
 
   // Initialize the Protomatter matrix
   ProtomatterStatus status = matrix.begin();
@@ -0,0 +1,55 @@
+// sqw_clock.h
+// Seconds counted from the DS3231's 1 Hz square-wave output, so the RTC only
+// has to be read over I²C once per minute instead of on every refresh.
+// This file is #included inside the sketch after `rtc` is declared; the
+// sketch defines RTC_SQW_PIN (wired to the DS3231 INT/SQW pin).
+//
+//   setup():  now = sqw_begin();
+//   refresh:  if (sqw_poll()) { now = sqw_resync(); /* rebuild digits */ }
+//
+// If no edge arrives for SQW_TIMEOUT_MS (SQW not wired), sqw_poll() asks
+// for a resync at that interval instead, so the clock never freezes.
+
+#ifndef SQW_TIMEOUT_MS
+#define SQW_TIMEOUT_MS 1500
+#endif
+
+volatile uint8_t sqw_ticks = 0;  // incremented by the ISR on every falling edge
+uint8_t  sqw_seen    = 0;        // ticks already folded into sqw_time
+uint32_t sqw_time    = 0;        // unixtime, advanced one second per tick
+unsigned long sqw_last_ms = 0;   // millis() of the last tick or resync
+
+void sqw_isr() { sqw_ticks++; }
+
+// Read the RTC over I²C and restart the count from it.
+DateTime sqw_resync() {
+  DateTime t  = rtc.now();
+  sqw_time    = t.unixtime();
+  sqw_seen    = sqw_ticks;
+  sqw_last_ms = millis();
+  return t;
+}
+
+// Enable the 1 Hz output, start counting edges and return the first reading.
+// The DS3231 advances its seconds register on the falling edge.
+DateTime sqw_begin() {
+  rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+  pinMode(RTC_SQW_PIN, INPUT_PULLUP); // SQW is open-drain
+  attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), sqw_isr, FALLING);
+  return sqw_resync();
+}
+
+// Fold pending ticks into sqw_time.  Returns true when the minute has just
+// rolled over (or the square wave has stopped) and the caller should resync.
+bool sqw_poll() {
+  uint8_t ticks = sqw_ticks; // single-byte read, no need to mask interrupts
+  unsigned long now_ms = millis();
+  if (ticks != sqw_seen) {
+    uint32_t minute = sqw_time / 60;
+    sqw_time   += (uint8_t)(ticks - sqw_seen);
+    sqw_seen    = ticks;
+    sqw_last_ms = now_ms;
+    return sqw_time / 60 != minute;
+  }
+  return now_ms - sqw_last_ms > SQW_TIMEOUT_MS;
+}
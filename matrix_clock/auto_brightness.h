@@ -0,0 +1,58 @@
+// auto_brightness.h
+// Ambient-light auto-brightness (ENABLE_AUTO_BRIGHTNESS).
+// This file is #included inside matrix_clock.ino after update_brightness();
+// the sketch defines LIGHT_SENSOR_PIN and provides light_task (callback
+// light_sample).
+//
+// light_task reads the sensor every LIGHT_SAMPLE_MS.  Readings are smoothed
+// by an exponential moving average (weight 1/2^LIGHT_EMA_SHIFT) and mapped
+// onto the steps of light_levels[].  The step only moves once the average
+// leaves the current step's band by more than LIGHT_HYSTERESIS counts, so a
+// room sitting on a boundary does not flicker between two levels, and the
+// colours and palette are only rebuilt when the step actually changes.
+//
+// The sensor must read higher in brighter light, 0–1023 (e.g. a
+// photoresistor from the pin to 3V3 with 10 kΩ from the pin to GND).
+
+#ifndef LIGHT_EMA_SHIFT
+#define LIGHT_EMA_SHIFT  3   // average over ~8 samples
+#endif
+#ifndef LIGHT_HYSTERESIS
+#define LIGHT_HYSTERESIS 24  // ADC counts past a band edge before stepping
+#endif
+
+// Brightness level of each step, darkest room first; the top step is
+// BRIGHTNESS.
+const uint8_t light_levels[] = {8, 24, 64, 128, BRIGHTNESS};
+
+#define LIGHT_STEPS (sizeof(light_levels) / sizeof(light_levels[0]))
+#define LIGHT_BAND  (1024 / LIGHT_STEPS) // ADC counts per step
+
+uint16_t light_ema  = 0; // averaged reading << LIGHT_EMA_SHIFT
+uint8_t  light_step = 0; // index into light_levels[]
+
+// Step for an averaged reading, without hysteresis.
+uint8_t light_step_for(uint16_t avg) {
+  uint8_t step = avg / LIGHT_BAND;
+  return step < LIGHT_STEPS ? step : LIGHT_STEPS - 1;
+}
+
+// light_task callback: fold in one reading and re-dim if the step changed.
+void light_sample() {
+  light_ema += analogRead(LIGHT_SENSOR_PIN) - (light_ema >> LIGHT_EMA_SHIFT);
+  const int16_t avg = light_ema >> LIGHT_EMA_SHIFT;
+  const int16_t lo  = light_step * LIGHT_BAND - LIGHT_HYSTERESIS;
+  const int16_t hi  = (light_step + 1) * LIGHT_BAND + LIGHT_HYSTERESIS;
+  if (avg >= lo && avg < hi) { return; }
+  light_step = light_step_for(avg);
+  update_brightness(light_levels[light_step]);
+  change_palette();
+}
+
+// Seed the average from one reading and return the starting brightness.
+uint8_t light_begin() {
+  const uint16_t raw = analogRead(LIGHT_SENSOR_PIN);
+  light_ema  = raw << LIGHT_EMA_SHIFT;
+  light_step = light_step_for(raw);
+  return light_levels[light_step];
+}
@@ -0,0 +1,164 @@
+// button_events.h
+// Interrupt-driven buttons: pin-change ISRs push timestamped edges into a
+// lock-free ring buffer, and the main loop turns them into gestures.
+// This file is #included inside matrix_clock.ino; the sketch provides
+// on_button(button, gesture) and btn_timer_task (callback btn_timeout).
+//
+//   BTN_SHORT  — pressed and released (after BTN_DOUBLE_MS if double-press
+//                detection is on)
+//   BTN_LONG   — held for BTN_LONG_MS; fires while still held
+//   BTN_DOUBLE — second press within BTN_DOUBLE_MS of the first release
+
+enum { BTN_PALETTE, BTN_PATTERN, BTN_COUNT };
+enum { BTN_SHORT, BTN_LONG, BTN_DOUBLE };
+
+void on_button(uint8_t button, uint8_t gesture);
+
+// ---- EVENT QUEUE ----
+// Single producer (the ISRs, which do not preempt each other) and single
+// consumer (buttons_update()).  Each side only writes its own index, so no
+// interrupt masking is needed; a full queue drops new edges.
+
+#define BTN_QUEUE_LEN 16 // power of two
+
+struct BtnEvent {
+  uint32_t ms;     // millis() at the edge
+  uint8_t  button; // BTN_PALETTE / BTN_PATTERN
+  uint8_t  down;   // pin level after the edge: 1 = pressed (LOW)
+};
+
+BtnEvent btn_queue[BTN_QUEUE_LEN];
+volatile uint8_t btn_head = 0; // next slot to fill, written by the ISRs
+volatile uint8_t btn_tail = 0; // next slot to read, written by the consumer
+
+// Keep the compiler from moving slot accesses across the index update.
+#define BTN_BARRIER() __asm__ volatile ("" ::: "memory")
+
+const uint8_t btn_pins[BTN_COUNT] = {BTN_PALETTE_PIN, BTN_PATTERN_PIN};
+
+void btn_push(uint8_t button) {
+  uint8_t h = btn_head;
+  if ((uint8_t)(h - btn_tail) == BTN_QUEUE_LEN) { return; }
+  BtnEvent &e = btn_queue[h % BTN_QUEUE_LEN];
+  e.ms     = millis();
+  e.button = button;
+  e.down   = digitalRead(btn_pins[button]) == LOW;
+  BTN_BARRIER();
+  btn_head = h + 1;
+}
+
+void btn_isr_palette() { btn_push(BTN_PALETTE); }
+void btn_isr_pattern() { btn_push(BTN_PATTERN); }
+
+// ---- GESTURES ----
+
+struct ButtonState {
+  bool     down;       // debounced level
+  bool     long_sent;  // BTN_LONG already fired for this press
+  bool     tap_held;   // a short press is waiting out the double-press window
+  bool     recheck;    // an edge was ignored as bounce; re-read the pin later
+  uint32_t edge_ms;    // time of the last accepted edge
+};
+
+ButtonState btn_state[BTN_COUNT];
+
+// Apply one edge.  Edges closer than BTN_DEBOUNCE_MS to the previous
+// accepted edge are contact bounce and ignored; the pin is then re-read once
+// the window closes, so a quick tap's release is not lost.
+void btn_edge(uint8_t b, bool down, uint32_t ms) {
+  ButtonState &s = btn_state[b];
+  if (down == s.down) { return; }
+  if (ms - s.edge_ms < BTN_DEBOUNCE_MS) { s.recheck = true; return; }
+  s.down    = down;
+  s.edge_ms = ms;
+  s.recheck = false;
+  if (down) {
+    s.long_sent = false;
+    if (s.tap_held) { s.tap_held = false; s.long_sent = true; on_button(b, BTN_DOUBLE); }
+  } else if (!s.long_sent) {
+    if (BTN_DOUBLE_MS) { s.tap_held = true; }
+    else               { on_button(b, BTN_SHORT); }
+  }
+}
+
+// Fire gestures whose deadline has passed and return the milliseconds until
+// the next one (0 = nothing pending).  A pending bounce re-check is always
+// the earliest deadline, since every deadline counts from edge_ms.
+uint32_t btn_deadlines(uint32_t ms) {
+  uint32_t next = 0;
+  for (uint8_t b = 0; b < BTN_COUNT; b++) {
+    ButtonState &s = btn_state[b];
+    if (s.recheck && (int32_t)(ms - (s.edge_ms + BTN_DEBOUNCE_MS)) >= 0) {
+      s.recheck = false;
+      btn_edge(b, digitalRead(btn_pins[b]) == LOW, ms);
+    }
+    uint32_t due;
+    if (s.recheck) {
+      due = s.edge_ms + BTN_DEBOUNCE_MS;
+    } else if (s.down && !s.long_sent) {
+      due = s.edge_ms + BTN_LONG_MS;
+      if ((int32_t)(ms - due) >= 0) {
+        // A release dropped by a full queue would leave us "held" forever.
+        // When it happened is unknown, so the press counts as a long one
+        // that is already over: the release fires no gesture.
+        if (digitalRead(btn_pins[b]) != LOW) {
+          s.long_sent = true;
+          btn_edge(b, false, ms);
+          continue;
+        }
+        s.long_sent = true;
+        on_button(b, BTN_LONG);
+        continue;
+      }
+    } else if (s.tap_held) {
+      due = s.edge_ms + BTN_DOUBLE_MS;
+      if ((int32_t)(ms - due) >= 0) {
+        s.tap_held = false;
+        on_button(b, BTN_SHORT);
+        continue;
+      }
+    } else {
+      continue;
+    }
+    uint32_t wait = due - ms;
+    if (!next || wait < next) { next = wait; }
+  }
+  return next;
+}
+
+// Re-arm btn_timer_task for the next re-check, long-press or double-press
+// deadline.
+void btn_arm() {
+  uint32_t wait = btn_deadlines(millis());
+  if (wait) { btn_timer_task.restartDelayed(wait); }
+  else      { btn_timer_task.disable(); }
+}
+
+// btn_timer_task callback: a debounce, long-press or double-press window
+// expired.
+void btn_timeout() { btn_arm(); }
+
+// Drain the queue.  Called once per loop() pass, so an edge is handled on
+// the first pass after the interrupt wakes the CPU.
+void buttons_update() {
+  uint8_t t = btn_tail;
+  if (t == btn_head) { return; }
+  while (t != btn_head) {
+    BTN_BARRIER();
+    const BtnEvent &e = btn_queue[t % BTN_QUEUE_LEN];
+    btn_edge(e.button, e.down, e.ms);
+    BTN_BARRIER();
+    btn_tail = ++t;
+  }
+  btn_arm();
+}
+
+// Attach the pin-change interrupts.
+void buttons_begin() {
+  for (uint8_t b = 0; b < BTN_COUNT; b++) {
+    pinMode(btn_pins[b], INPUT_PULLUP);
+    btn_state[b].edge_ms = millis() - BTN_DEBOUNCE_MS;
+  }
+  attachInterrupt(digitalPinToInterrupt(BTN_PALETTE_PIN), btn_isr_palette, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(BTN_PATTERN_PIN), btn_isr_pattern, CHANGE);
+}
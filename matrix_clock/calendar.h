@@ -0,0 +1,51 @@
+// calendar.h
+// Dated overlays that replace the date row for a whole day (ENABLE_CALENDAR).
+// This file is #included inside matrix_clock.ino after the overlay functions;
+// the sketch defines CALENDAR_ENTRIES as { month, day, overlay } initialisers.
+//
+// The table is constexpr and must be sorted by date, which is checked at
+// compile time.  calendar_update() is called with the displayed date when
+// the minute changes; it only searches the table when the day has changed,
+// and the result stays in calendar_overlay until the next day.
+
+struct CalendarEntry {
+  uint8_t month, day;  // 1–12, 1–31
+  void (*overlay)();   // draws the date row for that day, e.g. blaze_it
+};
+
+constexpr CalendarEntry calendar[] = { CALENDAR_ENTRIES };
+
+#define CALENDAR_COUNT (sizeof(calendar) / sizeof(calendar[0]))
+
+// Sort key of a date.
+constexpr uint16_t calendar_key(uint8_t month, uint8_t day) { return month * 32 + day; }
+
+constexpr bool calendar_sorted(const CalendarEntry *e, size_t n) {
+  return n < 2 || (calendar_key(e[0].month, e[0].day) < calendar_key(e[1].month, e[1].day) &&
+                   calendar_sorted(e + 1, n - 1));
+}
+static_assert(calendar_sorted(calendar, CALENDAR_COUNT),
+              "CALENDAR_ENTRIES must be sorted by month and day, one entry per date");
+
+void (*calendar_overlay)() = nullptr; // today's overlay, nullptr = show the date
+uint16_t calendar_day = 0;            // key of the day calendar_overlay is for
+
+// Binary-search the table for date; nullptr when it has no entry.
+void (*calendar_find(uint16_t key))() {
+  uint8_t lo = 0, hi = CALENDAR_COUNT;
+  while (lo < hi) {
+    const uint8_t mid = (lo + hi) / 2;
+    const uint16_t k = calendar_key(calendar[mid].month, calendar[mid].day);
+    if (k == key) { return calendar[mid].overlay; }
+    if (k < key) { lo = mid + 1; } else { hi = mid; }
+  }
+  return nullptr;
+}
+
+// Refresh calendar_overlay if the displayed date has moved to a new day.
+void calendar_update(const DateTime &local) {
+  const uint16_t key = calendar_key(local.month(), local.day());
+  if (key == calendar_day) { return; }
+  calendar_day     = key;
+  calendar_overlay = calendar_find(key);
+}
@@ -0,0 +1,70 @@
+// color_lut.h
+// Integer brightness and gamma for colour channels.
+// This file is #included inside the sketch after the matrix object is
+// declared; the sketch may define ENABLE_GAMMA (default 0).
+//
+// level_lut[] maps an 8-bit channel value to its output value at the current
+// brightness, so re-dimming is one 256-entry rebuild and every colour after
+// that is three table lookups — no float math on M0/M4 parts.
+//
+//   set_brightness_level(128);            // 0 = off, 255 = full
+//   uint16_t c = lut565(253, 152, 0);     // orange at that level
+//   constexpr uint16_t o = rgb565(253, 152, 0); // full brightness, in flash
+//   uint16_t d = dim565(o);               // o at that level
+
+#ifndef ENABLE_GAMMA
+#define ENABLE_GAMMA 0
+#endif
+
+// round(255 * (v / 255)^2.2): LED output is linear in the PWM duty, so
+// channel values chosen by eye are darkened mid-tones to look right.
+const uint8_t gamma8[256] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+    3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+    6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+   12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+   20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+   30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+   42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+   56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+   73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+   91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+  113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+  137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+  163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+  192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+  223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+uint8_t level_lut[256];          // channel value → output channel value
+uint8_t brightness_level = 255;  // level the table was built for
+
+// Rebuild level_lut[] for level (0 = off, 255 = full).  x / 255 is computed
+// as (x + 128) * 257 >> 16, which is exact for every channel × level product.
+void set_brightness_level(uint8_t level) {
+  brightness_level = level;
+  for (uint16_t v = 0; v < 256; v++) {
+    uint16_t c = ENABLE_GAMMA ? gamma8[v] : v;
+    level_lut[v] = ((uint32_t)(c * level + 128) * 257) >> 16;
+  }
+}
+
+// RGB565 colour of an 8-bit-per-channel colour at the current brightness.
+inline uint16_t lut565(uint8_t r, uint8_t g, uint8_t b) {
+  return matrix.color565(level_lut[r], level_lut[g], level_lut[b]);
+}
+
+// RGB565 of an 8-bit-per-channel colour at full brightness, resolved at
+// compile time (same packing as Adafruit_GFX::color565()).
+constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+// A full-brightness RGB565 colour at the current brightness.  Channels are
+// widened back to 8 bits (bit-replicated, so level 255 without gamma
+// returns c unchanged) and looked up in level_lut[].
+uint16_t dim565(uint16_t c) {
+  const uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+  return lut565((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
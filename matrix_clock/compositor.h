@@ -0,0 +1,185 @@
+// compositor.h
+// Layered frame composition (ENABLE_COMPOSITOR).
+// This file is #included inside matrix_clock.ino after framebuffer.h and
+// before glyph.h.  With the flag off, the layer calls below are no-ops and
+// the display helpers draw straight onto the canvas.
+//
+// Patterns draw the background into bg_layer (or ifb[] with
+// ENABLE_INDEXED_FB) instead of the canvas.  The display helpers draw into
+// 1-bit layer masks: begin_layer() redirects drawGlyph() and fb_fill_rect()
+// into the named layer, and the pen each glyph uses is recorded per column.
+// compose_frame() then walks the panel once in logical row-major order and
+// writes every canvas pixel exactly once:
+//
+//   background → LAYER_TIME → LAYER_SEPARATOR → LAYER_DATE → LAYER_OVERLAY
+//
+// Blend modes, applied where a layer's mask bit is set:
+//   BLEND_REPLACE — the layer's pen
+//   BLEND_PUNCH   — black, cutting through everything below
+//   BLEND_TINT    — the pen mixed over what is below by alpha/256
+
+enum { LAYER_TIME, LAYER_SEPARATOR, LAYER_DATE, LAYER_OVERLAY, LAYER_COUNT };
+enum { BLEND_REPLACE, BLEND_PUNCH, BLEND_TINT };
+
+#if ENABLE_COMPOSITOR
+
+// Each mask row is LAYER_WORDS 32-bit words covering the panel width, so
+// chained panels of any width up to MATRIX_WIDTH are covered; word 0's top
+// bit is logical column 0.  layout.h limits rotation to 0 and 2, so logical
+// rows and columns are the raw ones.
+#define LAYER_WORDS ((MATRIX_WIDTH + 31) / 32)
+
+struct Layer {
+  uint32_t rows[MATRIX_HEIGHT][LAYER_WORDS]; // mask, one bit per column
+  uint16_t col_pen[MATRIX_WIDTH];  // PEN_* value of the glyph covering each column
+  uint8_t  mode;                   // BLEND_*
+  uint8_t  alpha;                  // BLEND_TINT strength, 0–255
+  bool     used;                   // anything drawn this frame
+};
+
+Layer layers[LAYER_COUNT];
+Layer *draw_layer = nullptr;     // layer drawGlyph()/fb_fill_rect() write into
+
+// Bit of logical column x within its mask word.
+inline uint32_t layer_bit(int16_t x) { return 0x80000000UL >> (x & 31); }
+
+// Empty every layer; call at the start of each frame.
+void layers_clear() {
+  for (uint8_t l = 0; l < LAYER_COUNT; l++) {
+    memset(layers[l].rows, 0, sizeof(layers[l].rows));
+    layers[l].used = false;
+  }
+  draw_layer = nullptr;
+}
+
+// Send the following draws into layer id with the given blend mode.
+void begin_layer(uint8_t id, uint8_t mode, uint8_t alpha = 255) {
+  draw_layer = &layers[id];
+  draw_layer->mode  = mode;
+  draw_layer->alpha = alpha;
+  draw_layer->used  = true;
+}
+
+void end_layer() { draw_layer = nullptr; }
+
+// OR one clipped w-bit row mask (MSB = leftmost) into row y of the open
+// layer at column x.  drawGlyph() calls this once per glyph row; the blit
+// straddles at most two words.
+inline void layer_blit_row(int16_t x, int16_t y, uint32_t bits, uint8_t w) {
+  const int16_t word = x < 0 ? 0 : x >> 5;
+  const uint64_t v = (uint64_t)bits << (64 - w - (x - word * 32));
+  uint32_t *row = draw_layer->rows[y];
+  row[word] |= v >> 32;
+  if (word + 1 < LAYER_WORDS) { row[word + 1] |= (uint32_t)v; }
+}
+
+// Set (or, with set false, clear) the mask bits of columns x … x+w-1 of a
+// row, already clipped to the panel.
+void layer_span(uint32_t *row, int16_t x, int16_t w, bool set) {
+  while (w > 0) {
+    const int16_t n = min<int16_t>(w, 32 - (x & 31));
+    const uint32_t bits = (n == 32 ? 0xFFFFFFFFUL : ((1UL << n) - 1) << (32 - (x & 31) - n));
+    if (set) { row[x >> 5] |= bits; }
+    else     { row[x >> 5] &= ~bits; }
+    x += n;
+    w -= n;
+  }
+}
+
+// Record pen for the on-panel columns of a w-wide blit at x.
+void layer_pen(int16_t x, uint8_t w, uint16_t pen) {
+  for (int16_t c = max<int16_t>(x, 0); c < x + w && c < (int16_t)matrix.width(); c++) {
+    draw_layer->col_pen[c] = pen;
+  }
+}
+
+// fb_fill_rect() hook: fill a rectangle of the open layer.  Returns false
+// when no layer is open so the caller draws to the canvas instead.
+bool layer_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t pen) {
+  if (!draw_layer) { return false; }
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  w = min<int16_t>(w, matrix.width() - x);
+  h = min<int16_t>(h, matrix.height() - y);
+  if (w <= 0 || h <= 0) { return true; }
+  for (int16_t r = y; r < y + h; r++) { layer_span(draw_layer->rows[r], x, w, true); }
+  for (int16_t c = x; c < x + w; c++) { draw_layer->col_pen[c] = pen; }
+  return true;
+}
+
+// Erase an on-panel rectangle of layer id, keeping the rest of its mask,
+// so part of the layer can be redrawn.
+void layer_clear_rect(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h) {
+  for (int16_t r = y; r < y + h; r++) { layer_span(layers[id].rows[r], x, w, false); }
+}
+
+// RGB565 value of a pen.
+inline uint16_t pen_rgb(uint16_t pen) {
+#if ENABLE_INDEXED_FB
+  return ifb_lut[pen];
+#else
+  return pen;
+#endif
+}
+
+// Mix pen over px by alpha/256, per RGB565 channel.
+uint16_t tint565(uint16_t px, uint16_t pen, uint8_t alpha) {
+  int16_t r = px >> 11, g = (px >> 5) & 0x3F, b = px & 0x1F;
+  r += (((pen >> 11)        - r) * alpha) >> 8;
+  g += ((((pen >> 5) & 0x3F) - g) * alpha) >> 8;
+  b += (((pen & 0x1F)       - b) * alpha) >> 8;
+  return (r << 11) | (g << 5) | b;
+}
+
+// Background colour at raw canvas index i.
+inline uint16_t bg_pixel(int32_t i) {
+#if ENABLE_INDEXED_FB
+  return ifb_lut[(i & 1) ? ifb[i >> 1] & 0x0F : ifb[i >> 1] >> 4];
+#else
+  return bg_layer[i];
+#endif
+}
+
+// Compose background and layers into an on-panel rectangle of the canvas,
+// one write per pixel.  Pixels no layer touches are copied straight from
+// the background.
+void compose_rect(int16_t x0, int16_t y0, int16_t w, int16_t h) {
+  end_layer();
+  uint16_t *out = matrix.getBuffer();
+  for (int16_t y = y0; y < y0 + h; y++) {
+    uint32_t any[LAYER_WORDS] = {0};
+    for (uint8_t l = 0; l < LAYER_COUNT; l++) {
+      if (!layers[l].used) { continue; }
+      for (uint8_t i = 0; i < LAYER_WORDS; i++) { any[i] |= layers[l].rows[y][i]; }
+    }
+    FbCursor c = fb_cursor(x0, y);
+    for (int16_t x = x0; x < x0 + w; x++, c.origin += c.step_x) {
+      uint16_t px = bg_pixel(c.origin);
+      const uint32_t bit = layer_bit(x);
+      if (any[x >> 5] & bit) {
+        for (uint8_t l = 0; l < LAYER_COUNT; l++) {
+          const Layer &L = layers[l];
+          if (!L.used || !(L.rows[y][x >> 5] & bit)) { continue; }
+          switch (L.mode) {
+            case BLEND_PUNCH: px = 0; break;
+            case BLEND_TINT:  px = tint565(px, pen_rgb(L.col_pen[x]), L.alpha); break;
+            default:          px = pen_rgb(L.col_pen[x]); break;
+          }
+        }
+      }
+      out[c.origin] = px;
+    }
+  }
+}
+
+// Compose the whole panel in one pass.
+void compose_frame() { compose_rect(0, 0, matrix.width(), matrix.height()); }
+
+#else // !ENABLE_COMPOSITOR
+
+inline void layers_clear() {}
+inline void begin_layer(uint8_t, uint8_t, uint8_t = 255) {}
+inline void end_layer() {}
+inline void compose_frame() {}
+
+#endif // ENABLE_COMPOSITOR
@@ -0,0 +1,96 @@
+// digit_transition.h
+// Animated time-digit changes (ENABLE_TRANSITIONS).
+// This file is #included inside matrix_clock.ino after glyph.h; the sketch
+// provides transition_task (callback transition_step, TARGET_FPS interval,
+// TRANSITION_FRAMES iterations).  display_time() draws every digit through
+// digit_rows(), which with the flag off is simply num_rows[digits[d]].
+//
+// When access_rtc() changes digits[], only the positions whose value
+// changed animate, over TRANSITION_FRAMES frames:
+//   TRANSITION_SLIDE    — old digit slides out left, new one in from the right
+//   TRANSITION_ROLL     — old digit rolls down, new one in from the top
+//   TRANSITION_DISSOLVE — pixels switch from old to new in a scattered order
+// Each frame is built from the two digits' num_rows[] row masks into one
+// 10-byte row buffer per animating digit; nothing is precomputed.  The
+// sketch's render_digits() then redraws just those digits' cells.
+
+enum { TRANSITION_SLIDE, TRANSITION_ROLL, TRANSITION_DISSOLVE };
+
+#if ENABLE_TRANSITIONS
+
+uint8_t trans_from[4];     // digits[] before the change
+uint8_t trans_mask  = 0;   // bit d set = digit d is animating
+uint8_t trans_frame = 0;   // frames played, 0 … TRANSITION_FRAMES
+uint8_t trans_rows[4][10]; // current frame of each animating digit
+
+// Columns of row r that have switched to the new digit once `done` of the
+// 80 cells have.  Cell (r, c) switches at step (r*8 + c)*37 mod 80, a fixed
+// permutation (37 is coprime to 80) that scatters neighbouring pixels.
+uint8_t dissolve_mask(uint8_t r, uint8_t done) {
+  uint8_t m = 0;
+  for (uint8_t c = 0; c < 8; c++) {
+    if ((r * 8 + c) * 37 % 80 < done) { m |= 0x80 >> c; }
+  }
+  return m;
+}
+
+// Build frame trans_frame of every animating digit into trans_rows[].
+// Frame 0 is the old digit, frame TRANSITION_FRAMES the new one.
+void transition_render() {
+  const uint8_t f = trans_frame;
+  for (uint8_t d = 0; d < 4; d++) {
+    if (!(trans_mask & (1 << d))) { continue; }
+    const uint8_t *a = num_rows[trans_from[d]];
+    const uint8_t *b = num_rows[digits[d]];
+    for (uint8_t r = 0; r < 10; r++) {
+      uint8_t out;
+      if (DIGIT_TRANSITION == TRANSITION_SLIDE) {
+        const uint8_t s = 8 * f / TRANSITION_FRAMES;
+        out = (a[r] << s) | (b[r] >> (8 - s));
+      } else if (DIGIT_TRANSITION == TRANSITION_ROLL) {
+        const uint8_t off = 10 * f / TRANSITION_FRAMES;
+        out = r < off ? b[r + 10 - off] : a[r - off];
+      } else {
+        const uint8_t m = dissolve_mask(r, 80 * f / TRANSITION_FRAMES);
+        out = (a[r] & ~m) | (b[r] & m);
+      }
+      trans_rows[d][r] = out;
+    }
+  }
+}
+
+// Start animating from the digits in before[] to digits[].  A change of
+// layout (colon with a one-digit hour appearing or going) is not animated.
+void transition_start(const int *before) {
+  trans_mask = 0;
+  if (show_colon && !before[0] != !digits[0]) { return; }
+  for (uint8_t d = 0; d < 4; d++) {
+    trans_from[d] = before[d];
+    if (before[d] != digits[d]) { trans_mask |= 1 << d; }
+  }
+  if (!trans_mask) { return; }
+  trans_frame = 0;
+  transition_render();
+  transition_task.restartDelayed();
+}
+
+// transition_task callback: advance one frame, ending on the new digits,
+// and redraw only the cells that are moving.
+void transition_step() {
+  const uint8_t moving = trans_mask;
+  if (!moving) { return; }
+  if (++trans_frame >= TRANSITION_FRAMES) { trans_mask = 0; }
+  else                                    { transition_render(); }
+  render_digits(moving);
+}
+
+// Rows of the glyph to draw at digit position d this frame.
+inline const uint8_t *digit_rows(uint8_t d) {
+  return (trans_mask & (1 << d)) ? trans_rows[d] : num_rows[digits[d]];
+}
+
+#else // !ENABLE_TRANSITIONS
+
+inline const uint8_t *digit_rows(uint8_t d) { return num_rows[digits[d]]; }
+
+#endif // ENABLE_TRANSITIONS
@@ -0,0 +1,69 @@
+// dst_rules.h
+// Daylight-saving rules and cached transition instants (ENABLE_DST).
+// This file is #included inside matrix_clock.ino.
+//
+// The RTC keeps local *standard* time all year.  Each rule gives the two
+// transitions as "nth Sunday of a month at an hour of standard time"; they
+// are resolved to epoch seconds once per year, so dst_active() is a pair of
+// integer compares.
+
+// ---- RULE TABLE ----
+
+struct DstRule {
+  uint8_t start_month, start_sunday, start_hour; // sunday: 1–4 = nth, 5 = last
+  uint8_t end_month,   end_sunday,   end_hour;   // hours in local standard time
+};
+
+enum { DST_NONE, DST_US, DST_EU, DST_UK, DST_RULE_COUNT };
+
+const DstRule dst_rules[DST_RULE_COUNT] = {
+  { 0, 0, 0,   0, 0, 0 }, // DST_NONE
+  { 3, 2, 2,  11, 1, 1 }, // DST_US: 2nd Sun Mar 02:00 → 1st Sun Nov 02:00 daylight
+  { 3, 5, 2,  10, 5, 2 }, // DST_EU: last Sun Mar/Oct 01:00 UTC, as CET (UTC+1)
+  { 3, 5, 1,  10, 5, 1 }, // DST_UK: last Sun Mar/Oct 01:00 UTC, as GMT
+};
+
+// ---- CACHE ----
+
+uint8_t  dst_rule  = DST_RULE;   // active entry in dst_rules[]
+uint16_t dst_year  = 0;          // year the cached instants belong to (0 = stale)
+uint32_t dst_start = 0;          // unixtime DST begins in dst_year
+uint32_t dst_end   = 0;          // unixtime DST ends in dst_year
+
+// Day of month of the nth (1–4) or last (5) Sunday of month in year.
+uint8_t nth_sunday(uint16_t year, uint8_t month, uint8_t n) {
+  static const uint8_t month_days[12] = {31,28,31,30,31,30,31,31,30,31,30,31};
+  uint8_t days = month_days[month - 1] + (month == 2 && year % 4 == 0);
+  uint8_t first = 1 + (7 - DateTime(year, month, 1).dayOfTheWeek()) % 7;
+  uint8_t day = first + 7 * (n - 1);
+  while (day > days) { day -= 7; }
+  return day;
+}
+
+// Resolve the active rule's transitions for year into dst_start/dst_end.
+void dst_cache_year(uint16_t year) {
+  const DstRule &r = dst_rules[dst_rule];
+  dst_year = year;
+  if (!r.start_month) { dst_start = dst_end = 0; return; }
+  dst_start = DateTime(year, r.start_month, nth_sunday(year, r.start_month, r.start_sunday),
+                       r.start_hour).unixtime();
+  dst_end   = DateTime(year, r.end_month, nth_sunday(year, r.end_month, r.end_sunday),
+                       r.end_hour).unixtime();
+}
+
+// Switch rules at runtime (e.g. from a settings menu).
+void set_dst_rule(uint8_t rule) {
+  if (rule >= DST_RULE_COUNT) { return; }
+  dst_rule = rule;
+  dst_year = 0;
+}
+
+// True when standard time t falls inside the active rule's DST window.
+// A window that wraps the new year (southern-hemisphere rules) has
+// dst_start > dst_end.
+bool dst_active(const DateTime &t) {
+  if (t.year() != dst_year) { dst_cache_year(t.year()); }
+  uint32_t s = t.unixtime();
+  if (dst_start <= dst_end) { return s >= dst_start && s < dst_end; }
+  return s >= dst_start || s < dst_end;
+}
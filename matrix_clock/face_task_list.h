@@ -1,192 +1,183 @@
 // face_task_list.h
 // Background pattern functions and palette/ink management for matrix_clock.
 // This file is #included directly inside matrix_clock.ino after all global
-// variable declarations, so it can reference matrix, palette, scroll, etc.
-
-// Convenience macros: set all four ink_color[] slots to black or white
-#define BLACK_INK ink_swap(BLACK,BLACK,BLACK,BLACK)
-#define WHITE_INK ink_swap(WHITE,WHITE,WHITE,WHITE)
+// variable declarations, so it can reference matrix, palette, etc.
 
 // ---- BACKGROUND PATTERN CALLBACKS -----------------------------------------
 // Each function fills the matrix with a colour pattern and is registered as
-// the callback for face_task by switch_pattern().
+// the callback for face_task by switch_pattern().  The geometric patterns
+// are lookups into the compile-time maps in pattern_maps.h.
 
-// Animated scrolling diagonal stripes that advance each frame
+// Animated scrolling diagonal stripes.  The stripes advance one palette
+// step per face_task tick, so the speed is set by switch_pattern() and does
+// not depend on the frame rate.
 void pattern_scroll_diagonal() {
-  if (palette_size == 6) {
-    for (int i = 0; i < 48; i++) {
-      matrix.drawLine(0, i, i, 0, palette[(abs(i - scroll) % palette_size)]);
-    }
-  } else {
-    for (int i = 0; i < 24; i++) {
-      matrix.drawLine(0, 2*i,   2*i,   0, palette[(abs(i - scroll) % palette_size)]);
-      matrix.drawLine(0, 2*i+1, 2*i+1, 0, palette[(abs(i - scroll) % palette_size)]);
-    }
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_scroll_diagonal), face_task.getRunCounter() % palette_size);
 }
 
 // Static diagonal stripes (no animation)
 void pattern_diagonal() {
-  for (int i = 0; i < 48; i++) {
-    matrix.drawLine(0, i, i, 0, palette[i % palette_size]);
-  }
-  for (int i = 0; i < 24; i++) {
-    matrix.drawLine(0, 2*i,   2*i,   0, palette[i % palette_size]);
-    matrix.drawLine(0, 2*i+1, 2*i+1, 0, palette[i % palette_size]);
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_diagonal), 0);
 }
 
 // Solid colour blocks, one per digit column — best without colon shift
 void pattern_blocks() {
-  if (palette_size == 6) {
-    matrix.fillRect(0,  0, 6, 11, palette[0]);
-    matrix.fillRect(6,  0, 5, 11, palette[1]);
-    matrix.fillRect(11, 0, 5, 11, palette[2]);
-    matrix.fillRect(16, 0, 5, 11, palette[3]);
-    matrix.fillRect(21, 0, 5, 11, palette[4]);
-    matrix.fillRect(26, 0, 6, 11, palette[5]);
-  }
-  if (palette_size == 4) {
-    for (int i = 0; i < 4; i++) {
-      matrix.fillRect(i * 8, 0, 8, 11, palette[i]);
-    }
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_blocks), 0);
 }
 
 // Thin horizontal stripes, one stripe per palette colour per row
 void pattern_h_thin() {
-  for (int i = 0; i < 12; i++) {
-    matrix.drawFastHLine(0, i, 32, palette[i % palette_size]);
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_h_thin), 0);
 }
 
 // Thick horizontal bands, evenly dividing the clock area between palette colours
 void pattern_h_thick() {
-  for (int i = 0; i < palette_size; i++) {
-    matrix.fillRect(0, i * (12 / palette_size), 32, 12 / palette_size, palette[i]);
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_h_thick), 0);
 }
 
 // Thin vertical stripes, one stripe per palette colour per column
 void pattern_v_thin() {
-  for (int i = 0; i < 32; i++) {
-    matrix.drawFastVLine(i, 0, 11, palette[i % palette_size]);
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_v_thin), 0);
 }
 
-// Thick vertical bands (uses same formula as h_thick but orientation differs)
+// Thick vertical stripes, the same band width as h_thick, across the panel
 void pattern_v_thick() {
-  for (int i = 0; i < palette_size; i++) {
-    matrix.fillRect(i * (12 / palette_size), 0, 12 / palette_size, 11, palette[i]);
-  }
+  fill_from_map(PM_FOR_PALETTE(pm_v_thick), 0);
 }
 
-// Random per-pixel colour from the active palette
+// Random per-pixel colour from the active palette.  Orientation does not
+// matter for noise, so the raw canvas is filled in one linear pass.
 void pattern_random() {
-  for (int x = 0; x < 32; x++) {
-    for (int y = 0; y < 16; y++) {
-      matrix.drawPixel(x, y, palette[random(palette_size)]);
-    }
+  uint16_t *buf = fb_surface();
+  for (int i = 0; i < MATRIX_WIDTH * MATRIX_HEIGHT; i++) {
+    fb_write(buf, i, PEN_PALETTE(random(palette_size)));
   }
 }
 
-// ---- PATTERN SWITCHER ------------------------------------------------------
+// ---- PATTERN TABLE ---------------------------------------------------------
+// Static patterns only change when the time, date, palette or pattern does.
+// With ENABLE_LOW_POWER they are drawn once per change instead of on a timer.
+
+struct PatternInfo {
+  void (*draw)();        // face_task callback
+  uint16_t interval_ms;  // face_task interval while animated
+  bool animated;         // output depends on the tick, not just the inputs
+};
+
+const PatternInfo patterns[] = {
+  { &pattern_scroll_diagonal, 100, true  }, // 0
+  { &pattern_diagonal,        25,  false }, // 1
+  { &pattern_blocks,          25,  false }, // 2
+  { &pattern_h_thin,          100, false }, // 3
+  { &pattern_h_thick,         25,  false }, // 4
+  { &pattern_v_thin,          100, false }, // 5
+  { &pattern_v_thick,         25,  false }, // 6
+  { &pattern_random,          100, true  }, // 7
+};
+#define PATTERN_COUNT (int)(sizeof(patterns) / sizeof(patterns[0]))
+
+bool face_animated = true; // active pattern's PatternInfo::animated
+
+// ---- BACKGROUND CACHE ------------------------------------------------------
+// Static patterns are rendered once into bg_cache (framebuffer.h) and
+// restored from it on every later face_task run.  The cache is dropped by
+// switch_pattern(), change_palette() and update_brightness().
+
+void (*bg_draw)() = nullptr; // static pattern behind the cache
+bool bg_cache_valid = false;
+
+void invalidate_background() { bg_cache_valid = false; }
+
+// face_task callback for static patterns.
+void draw_cached_background() {
+  if (bg_cache_valid) { fb_restore_background(); return; }
+  bg_draw();
+  fb_save_background();
+  bg_cache_valid = true;
+}
 
-// Set face_task to run the chosen background pattern
-void switch_pattern(int pattern) {
-  switch (pattern) {
-    case 0: face_task.setCallback(&pattern_scroll_diagonal); face_task.setInterval(100); break;
-    case 1: face_task.setCallback(&pattern_diagonal);        face_task.setInterval(25);  break;
-    case 2: face_task.setCallback(&pattern_blocks);          face_task.setInterval(25);  break;
-    case 3: face_task.setCallback(&pattern_h_thin);          face_task.setInterval(100); break;
-    case 4: face_task.setCallback(&pattern_h_thick);         face_task.setInterval(25);  break;
-    case 5: face_task.setCallback(&pattern_v_thin);  face_task.setInterval(100); break;
-    case 6: face_task.setCallback(&pattern_v_thick); face_task.setInterval(25);  break;
-    case 7: face_task.setCallback(&pattern_random);          face_task.setInterval(100); break;
+// ---- REDRAW SCHEDULING -----------------------------------------------------
+
+// Mark the frame stale.  Animated faces repaint on their own timers; a
+// static face (ENABLE_LOW_POWER) runs face_task and render_task once.
+// face_task and render_task are added to the scheduler last, in that
+// order, so the background is drawn before the time is composited over it
+// in the same pass, even when a task earlier in the pass asked.
+void request_redraw() {
+#if ENABLE_LOW_POWER
+  if (face_animated) { return; }
+  face_task.restart();
+  render_task.restart();
+#endif
+}
+
+// Run both tasks forever (animated) or once per request_redraw() (static).
+void set_face_timing(bool animated) {
+  face_animated = animated;
+#if ENABLE_LOW_POWER
+  long runs = animated ? TASK_FOREVER : TASK_ONCE;
+  face_task.setIterations(runs);
+  render_task.setIterations(runs);
+  if (animated) {
+    face_task.enableIfNot();
+    render_task.enableIfNot();
+  } else {
+    request_redraw();
   }
+#endif
 }
 
-// ---- PALETTE AND INK HELPERS -----------------------------------------------
+// ---- PATTERN SWITCHER ------------------------------------------------------
 
-// Load up to 6 colours into the active palette
-void pal_swap(uint16_t zero, uint16_t one, uint16_t two, uint16_t three,
-              uint16_t four = 0, uint16_t five = 0) {
-  palette[0] = zero;  palette[1] = one;  palette[2] = two;
-  palette[3] = three; palette[4] = four; palette[5] = five;
-}
+#if ENABLE_PROFILE
+// With ENABLE_PROFILE face_task runs the pattern through face_profiled()
+// so every pattern is timed in one place.
+void (*face_draw)() = nullptr;
+void face_profiled() { PROF_TASK(PROF_FACE, face_task); face_draw(); }
+#endif
 
-// Set the per-digit ink colour for all four digit positions
-void ink_swap(uint16_t zero, uint16_t one, uint16_t two, uint16_t three) {
-  ink_color[0] = zero; ink_color[1] = one;
-  ink_color[2] = two;  ink_color[3] = three;
+// Set face_task to run the chosen background pattern (through the
+// background cache when it is static)
+void switch_pattern(int pattern) {
+  const PatternInfo &p = patterns[pattern];
+  invalidate_background();
+  bg_draw = p.draw;
+  void (*draw)() = p.animated ? p.draw : &draw_cached_background;
+#if ENABLE_PROFILE
+  face_draw = draw;
+  draw = &face_profiled;
+#endif
+  face_task.setCallback(draw);
+  face_task.setInterval(p.interval_ms);
+  set_face_timing(p.animated);
 }
 
-// Apply the palette indexed by current_palette to palette[] and ink_color[]
+// ---- PALETTE AND INK HELPERS -----------------------------------------------
+
+// Load the palette numbered current_palette from palettes[] into palette[]
+// and ink_color[] at the current brightness, and schedule a redraw
 void change_palette() {
-  switch (current_palette) {
-    case 1:  // Rainbow — black digits
-      pal_swap(RED, ORANGE, YELLOW, GREEN, BLUE, PURPLE);
-      palette_size = 6; BLACK_INK; break;
-
-    case 2:  // Rainbow — white digits
-      pal_swap(RED, ORANGE, YELLOW, GREEN, BLUE, PURPLE);
-      palette_size = 6; WHITE_INK; break;
-
-    case 3:  // Red/Blue/Yellow/White — black digits
-      pal_swap(RED, BLUE, YELLOW, WHITE);
-      palette_size = 4; BLACK_INK; break;
-
-    case 4:  // Pure RGB + White — black digits
-      pal_swap(PURE_RED, PURE_GREEN, PURE_BLUE, WHITE);
-      palette_size = 4; BLACK_INK; break;
-
-    case 5:  // CMY + Black (CMYK-like) — white digits
-      pal_swap(CYAN, MAGENTA, YELLOW, BLACK);
-      palette_size = 4; WHITE_INK; break;
-
-    case 6:  // Pastel pink/green — black digits
-      pal_swap(matrix.color565(204,232,219), matrix.color565(193,212,227),
-               matrix.color565(190,180,214), matrix.color565(250,218,226),
-               matrix.color565(248,179,202), matrix.color565(204,151,193));
-      palette_size = 6; BLACK_INK; break;
-
-    case 7:  // "Wilderness" earth tones — black digits
-      pal_swap(matrix.color565(63,53,53),   matrix.color565(169,92,74),
-               matrix.color565(214,175,116), matrix.color565(135,163,100),
-               matrix.color565(74,138,118),  matrix.color565(61,80,112));
-      palette_size = 6; BLACK_INK; break;
-
-    case 8:  // Duke University palette — black digits
-      pal_swap(DUKE_BLUE, GRAY, WHITE, DUKE_BLUE);
-      palette_size = 4; BLACK_INK; break;
-
-    case 9:  // Purple/Yellow contrast
-      pal_swap(PURPLE, YELLOW, PURPLE, YELLOW);
-      palette_size = 4;
-      ink_swap(YELLOW, PURPLE, YELLOW, PURPLE); break;
-
-    case 10: // Orange/Cyan contrast
-      pal_swap(ORANGE, BLACK, BLUE, BLACK);
-      palette_size = 4;
-      ink_swap(BLUE, ORANGE, ORANGE, BLUE); break;
-
-    case 11: // Monochrome (black/white) — grey digits
-      pal_swap(BLACK, WHITE, BLACK, WHITE);
-      palette_size = 4;
-      ink_swap(GRAY, GRAY, GRAY, GRAY); break;
-  }
+  const PaletteDef &p = palettes[current_palette - 1];
+  for (uint8_t i = 0; i < 6; i++) { palette[i] = i < p.size ? dim565(p.colors[i]) : 0; }
+  for (uint8_t d = 0; d < 4; d++) { ink_color[d] = dim565(p.ink[d]); }
+  palette_size = p.size;
+#if ENABLE_INDEXED_FB
+  ifb_update_lut(); // the only work a palette swap needs in indexed mode
+#endif
+  invalidate_background();
+  request_redraw();
 }
 
-// Cycle to the next palette (wraps 11 → 1 to stay within valid range 1–11)
+// Cycle to the next palette (wraps PALETTE_COUNT → 1)
 void change_pal_helper() {
   current_palette += 1;
-  if (current_palette == 12) { current_palette = 1; }
+  if (current_palette > PALETTE_COUNT) { current_palette = 1; }
 }
 
-// Cycle to the next pattern (wraps at 8 back to 0)
+// Cycle to the next pattern (wraps at PATTERN_COUNT back to 0)
 void change_pat_helper() {
   current_pattern += 1;
-  if (current_pattern == 8) { current_pattern = 0; }
+  if (current_pattern == PATTERN_COUNT) { current_pattern = 0; }
 }
 
 // Stop the background pattern task
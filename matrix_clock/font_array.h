@@ -2,7 +2,13 @@
 #include "my_char.h"
 char daysOfTheWeek[7][12] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
 
-int num[11][80] = {
+// The 0/1 tables below are the editable source for every glyph.  They are
+// constexpr, so they never occupy RAM: the drawing code only reads the
+// bit-packed *_rows tables at the bottom of this file, which are generated
+// from them at compile time and stored in flash.
+
+// 8×10 digit bitmaps (0-9) plus the colon glyph (10), flat 80 values each.
+constexpr int num[11][80] = {
 //zero:
 {
  0,0,1,1,1,0,0,0,
@@ -147,9 +153,8 @@ int num[11][80] = {
   0,0,0,0,0,0,0,0,
 }
 };
-//values 0-79 need to become an x and a y
 
-int small_num[10][15] = {
+constexpr int small_num[10][15] = {
 {1,1,1,
  1,0,1,
  1,0,1,
@@ -202,7 +207,7 @@ int small_num[10][15] = {
  0,0,1} //9
 };
 
-int letters[26][15] = {
+constexpr int letters[26][15] = {
 {1,1,1,
  1,0,1,
  1,1,1,
@@ -335,4 +340,46 @@ int letters[26][15] = {
  1,1,1},//Z
 };
 
-int months[12][3] = {{9,0,13}, {5,4,1}, {12,0,17}, {0,15,17}, {12,0,24}, {9,20,13}, {9,20,11}, {0,20,6}, {18,4,15}, {14,2,19}, {13,14,21}, {3,4,2}};
+// ---- BIT-PACKED GLYPH ROWS -------------------------------------------------
+// One bitmask per glyph row, most-significant used bit = leftmost column.
+// e.g. the top row of "0" (0,0,1,1,1,0,0,0) packs to 0b00111000.
+
+// Pack w flat 0/1 pixels starting at px into a row bitmask.
+constexpr uint8_t pack_row(const int *px, int w) {
+  return w == 0 ? 0 : (uint8_t)((px[0] ? 1 << (w - 1) : 0) | pack_row(px + 1, w - 1));
+}
+
+#define NUM_ROW(g, r)    pack_row(&num[g][(r) * 8], 8)
+#define NUM_ROWS(g)      { NUM_ROW(g, 0), NUM_ROW(g, 1), NUM_ROW(g, 2), NUM_ROW(g, 3), NUM_ROW(g, 4), \
+                           NUM_ROW(g, 5), NUM_ROW(g, 6), NUM_ROW(g, 7), NUM_ROW(g, 8), NUM_ROW(g, 9) }
+#define SMALL_ROWS(t, g) { pack_row(&t[g][0], 3), pack_row(&t[g][3], 3), pack_row(&t[g][6], 3), \
+                           pack_row(&t[g][9], 3), pack_row(&t[g][12], 3) }
+
+// 8×10 digits 0-9 and the colon glyph (10): num_rows[glyph][row]
+const uint8_t num_rows[11][10] = {
+  NUM_ROWS(0), NUM_ROWS(1), NUM_ROWS(2), NUM_ROWS(3), NUM_ROWS(4), NUM_ROWS(5),
+  NUM_ROWS(6), NUM_ROWS(7), NUM_ROWS(8), NUM_ROWS(9), NUM_ROWS(10)
+};
+
+// 3×5 digits 0-9: small_num_rows[digit][row]
+const uint8_t small_num_rows[10][5] = {
+  SMALL_ROWS(small_num, 0), SMALL_ROWS(small_num, 1), SMALL_ROWS(small_num, 2),
+  SMALL_ROWS(small_num, 3), SMALL_ROWS(small_num, 4), SMALL_ROWS(small_num, 5),
+  SMALL_ROWS(small_num, 6), SMALL_ROWS(small_num, 7), SMALL_ROWS(small_num, 8),
+  SMALL_ROWS(small_num, 9)
+};
+
+// 3×5 letters A-Z: letter_rows[letter][row]
+const uint8_t letter_rows[26][5] = {
+  SMALL_ROWS(letters, 0),  SMALL_ROWS(letters, 1),  SMALL_ROWS(letters, 2),  SMALL_ROWS(letters, 3),
+  SMALL_ROWS(letters, 4),  SMALL_ROWS(letters, 5),  SMALL_ROWS(letters, 6),  SMALL_ROWS(letters, 7),
+  SMALL_ROWS(letters, 8),  SMALL_ROWS(letters, 9),  SMALL_ROWS(letters, 10), SMALL_ROWS(letters, 11),
+  SMALL_ROWS(letters, 12), SMALL_ROWS(letters, 13), SMALL_ROWS(letters, 14), SMALL_ROWS(letters, 15),
+  SMALL_ROWS(letters, 16), SMALL_ROWS(letters, 17), SMALL_ROWS(letters, 18), SMALL_ROWS(letters, 19),
+  SMALL_ROWS(letters, 20), SMALL_ROWS(letters, 21), SMALL_ROWS(letters, 22), SMALL_ROWS(letters, 23),
+  SMALL_ROWS(letters, 24), SMALL_ROWS(letters, 25)
+};
+
+#undef NUM_ROW
+#undef NUM_ROWS
+#undef SMALL_ROWS
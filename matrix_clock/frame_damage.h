@@ -0,0 +1,64 @@
+// frame_damage.h
+// Frame-level dirty tracking between the drawing helpers and the panel.
+// This file is #included inside matrix_clock.ino after the matrix object is
+// declared.
+//
+// Every drawing helper (GFX primitives or direct buffer writes) ends up in the
+// matrix canvas, so damage is detected by hashing each physical row of the
+// canvas and comparing it with the hash recorded when that row was last shown.
+// present_frame() skips matrix.show() entirely when no row changed.
+//
+// Protomatter's show() always converts the whole canvas into bitplanes; there
+// is no public per-row conversion, so the changed-row mask only gates show()
+// and cannot narrow it.
+
+uint32_t shown_row_hash[MATRIX_HEIGHT];  // row hashes of the last frame shown
+unsigned long frames_submitted = 0;      // present_frame() calls that ran matrix.show()
+unsigned long frames_skipped   = 0;      // present_frame() calls with nothing to show
+bool     damage_valid     = false;       // false until the first frame has been shown
+
+// 32-bit FNV-1a hash of one row of RGB565 pixels.
+uint32_t row_hash(const uint16_t *px, uint16_t n) {
+  uint32_t h = 2166136261UL;
+  for (uint16_t i = 0; i < n; i++) {
+    h = (h ^ px[i]) * 16777619UL;
+  }
+  return h;
+}
+
+// Hash the canvas rows in rows (bit y = raw row y; all of them until the
+// first frame is shown); record and return the mask of rows that changed.
+uint32_t scan_damage(uint32_t rows = ALL_ROWS) {
+  const uint16_t *buf = matrix.getBuffer();
+  uint32_t mask = 0;
+  if (!damage_valid) { rows = ALL_ROWS; }
+  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
+    if (!(rows & (1UL << y))) { continue; }
+    uint32_t h = row_hash(buf + y * MATRIX_WIDTH, MATRIX_WIDTH);
+    if (!damage_valid || h != shown_row_hash[y]) {
+      shown_row_hash[y] = h;
+      mask |= 1UL << y;
+    }
+  }
+  damage_valid = true;
+  return mask;
+}
+
+// Push the canvas to the panel only when at least one row changed.
+// With ENABLE_INDEXED_FB the indexed buffer is resolved into the canvas first
+// (compose_frame() does that itself under ENABLE_COMPOSITOR).  Callers that
+// redrew only part of the frame pass the raw rows they touched.
+void present_frame(uint32_t rows = ALL_ROWS) {
+#if ENABLE_INDEXED_FB && !ENABLE_COMPOSITOR
+  ifb_resolve(rows);
+#endif
+  if (!scan_damage(rows)) {
+    frames_skipped++;
+    return;
+  }
+  {
+    PROF_SCOPE(PROF_SHOW);
+    matrix.show();
+  }
+  frames_submitted++;
+}
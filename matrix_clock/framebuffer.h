@@ -0,0 +1,130 @@
+// framebuffer.h
+// Direct access to the Protomatter canvas (GFXcanvas16::getBuffer()) for the
+// hot drawing paths, bypassing the per-pixel virtual drawPixel() call with
+// its rotation transform and bounds checks.
+// This file is #included inside matrix_clock.ino after the matrix object is
+// declared.
+//
+// The canvas is stored unrotated, MATRIX_WIDTH × MATRIX_HEIGHT, row-major.
+// A blit resolves the display rotation once into a starting index plus the
+// raw-buffer strides for one logical step right (step_x) and down (step_y).
+
+struct FbCursor {
+  int32_t origin;  // raw buffer index of logical (x, y)
+  int16_t step_x;  // raw index delta for x + 1
+  int16_t step_y;  // raw index delta for y + 1
+};
+
+// Map logical (x, y) under the current rotation to a raw-buffer cursor.
+// (x, y) itself may lie off the panel; callers clip before writing.
+FbCursor fb_cursor(int16_t x, int16_t y) {
+  const int16_t W = MATRIX_WIDTH, H = MATRIX_HEIGHT;
+  FbCursor c;
+  switch (matrix.getRotation()) {
+    case 1:  c.origin = (int32_t)x * W + (W - 1 - y);           c.step_x =  W; c.step_y = -1; break;
+    case 2:  c.origin = (int32_t)(H - 1 - y) * W + (W - 1 - x); c.step_x = -1; c.step_y = -W; break;
+    case 3:  c.origin = (int32_t)(H - 1 - x) * W + y;           c.step_x = -W; c.step_y =  1; break;
+    default: c.origin = (int32_t)y * W + x;                     c.step_x =  1; c.step_y =  W; break;
+  }
+  return c;
+}
+
+#if ENABLE_COMPOSITOR && !ENABLE_INDEXED_FB
+uint16_t bg_layer[MATRIX_WIDTH * MATRIX_HEIGHT]; // background layer, raw canvas layout
+#endif
+
+// Buffer the background patterns draw into: the canvas, or bg_layer when
+// compositor.h composes the frame.  Ignored by fb_write() in indexed mode.
+inline uint16_t *fb_surface() {
+#if ENABLE_COMPOSITOR && !ENABLE_INDEXED_FB
+  return bg_layer;
+#else
+  return matrix.getBuffer();
+#endif
+}
+
+// Write one pen (RGB565, or a colour slot with ENABLE_INDEXED_FB) at raw
+// index i.  Every fast-path blit writes through here.
+inline void fb_write(uint16_t *buf, int32_t i, uint16_t pen) {
+#if ENABLE_INDEXED_FB
+  ifb_write(i, pen);
+#else
+  buf[i] = pen;
+#endif
+}
+
+// Raw canvas rows (bit y = raw row y) covered by logical rows y … y+h-1.
+// Under a quarter turn logical rows are raw columns, so every row.
+uint32_t fb_raw_rows(int16_t y, int16_t h) {
+  const uint32_t band = (h >= 32 ? ALL_ROWS : (1UL << h) - 1);
+  switch (matrix.getRotation()) {
+    case 0:  return band << y;
+    case 2:  return band << (MATRIX_HEIGHT - y - h);
+    default: return ALL_ROWS;
+  }
+}
+
+// Bitmask of the columns of a w-wide (≤ 32) blit at x that land on the
+// panel, in glyph row order (most-significant used bit = leftmost column).
+uint32_t fb_clip_cols(int16_t x, uint8_t w) {
+  uint32_t mask = (w >= 32) ? 0xFFFFFFFFUL : (1UL << w) - 1;
+  if (x < 0)                     { mask = (-x >= w) ? 0 : mask & ((1UL << (w + x)) - 1); }
+  if (x + w > matrix.width())    { int16_t cut = x + w - matrix.width();
+                                   mask = (cut >= w) ? 0 : mask & ~((1UL << cut) - 1); }
+  return mask;
+}
+
+#if ENABLE_COMPOSITOR
+bool layer_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t pen); // compositor.h
+#endif
+
+// Fill a w × h rectangle at logical (x, y) with pen, clipped to the panel
+// (or into the open compositor layer).
+void fb_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t pen) {
+#if ENABLE_COMPOSITOR
+  if (layer_fill_rect(x, y, w, h, pen)) { return; }
+#endif
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  w = min<int16_t>(w, matrix.width() - x);
+  h = min<int16_t>(h, matrix.height() - y);
+  if (w <= 0 || h <= 0) { return; }
+  uint16_t *buf = fb_surface();
+  FbCursor c = fb_cursor(x, y);
+  for (int16_t r = 0; r < h; r++, c.origin += c.step_y) {
+    int32_t i = c.origin;
+    for (int16_t col = 0; col < w; col++, i += c.step_x) { fb_write(buf, i, pen); }
+  }
+}
+
+// ---- BACKGROUND CACHE ----
+// A raw copy of the drawing surface (the canvas, or ifb[] with
+// ENABLE_INDEXED_FB), so a static background can be put back with one
+// memcpy instead of being redrawn.
+
+#if ENABLE_INDEXED_FB
+uint8_t  bg_cache[sizeof(ifb)];
+#define BG_SURFACE ((void *)ifb)
+#else
+uint16_t bg_cache[MATRIX_WIDTH * MATRIX_HEIGHT];
+#define BG_SURFACE ((void *)fb_surface())
+#endif
+
+void fb_save_background()    { memcpy(bg_cache, BG_SURFACE, sizeof(bg_cache)); }
+void fb_restore_background() { memcpy(BG_SURFACE, bg_cache, sizeof(bg_cache)); }
+
+// Put back an on-panel logical rectangle of the saved background.
+void fb_restore_rect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint16_t *buf = fb_surface();
+  FbCursor c = fb_cursor(x, y);
+  for (int16_t r = 0; r < h; r++, c.origin += c.step_y) {
+    int32_t i = c.origin;
+    for (int16_t col = 0; col < w; col++, i += c.step_x) {
+#if ENABLE_INDEXED_FB
+      fb_write(buf, i, (i & 1) ? bg_cache[i >> 1] & 0x0F : bg_cache[i >> 1] >> 4);
+#else
+      fb_write(buf, i, bg_cache[i]);
+#endif
+    }
+  }
+}
@@ -0,0 +1,47 @@
+// glyph.h
+// Generic blitter for the bit-packed glyph tables in font_array.h.
+// This file is #included inside matrix_clock.ino after framebuffer.h and
+// compositor.h, and writes straight into the matrix canvas (or the open
+// compositor layer).  Glyphs are drawn at the face scale from layout.h.
+
+// A W-bit glyph row widened to W × S columns, each bit repeated S times
+// (most-significant used bit still the leftmost column).
+template <uint8_t W, uint8_t S>
+inline uint32_t glyph_scale_row(uint8_t bits) {
+  if (S == 1) { return bits; }
+  uint32_t out = 0;
+  for (int8_t b = W - 1; b >= 0; b--) {
+    out = (out << S) | (((bits >> b) & 1) ? (1UL << S) - 1 : 0);
+  }
+  return out;
+}
+
+// Draw a W-wide, H-tall glyph with its top-left corner at pixel (x, y),
+// each glyph pixel LAYOUT_SCALE × LAYOUT_SCALE panel pixels.
+//   rows  — H row bitmasks, most-significant used bit = leftmost column
+//   pen   — colour for the drawn pixels (a PEN_* value)
+//   bg    — when false, draw the lit (foreground) pixels;
+//           when true,  draw the unlit (background) pixels instead
+// Clipping and rotation are resolved once per glyph, not per pixel.
+template <uint8_t W, uint8_t H>
+void drawGlyph(int16_t x, int16_t y, const uint8_t *rows, uint16_t pen, bool bg = false) {
+  const uint8_t S = LAYOUT_SCALE, SW = W * S;
+  const uint32_t cols = fb_clip_cols(x, SW);
+  if (!cols) { return; }
+#if ENABLE_COMPOSITOR
+  if (draw_layer) { layer_pen(x, SW, pen); }
+#endif
+  uint16_t *buf = fb_surface();
+  FbCursor c = fb_cursor(x + SW - 1, y); // start at the rightmost column: bit 0
+  for (uint8_t r = 0; r < H * S; r++, c.origin += c.step_y) {
+    if (y + r < 0 || y + r >= matrix.height()) { continue; }
+    const uint8_t src = bg ? ~rows[r / S] : rows[r / S];
+    uint32_t bits = glyph_scale_row<W, S>(src & ((1 << W) - 1)) & cols;
+#if ENABLE_COMPOSITOR
+    if (draw_layer) { layer_blit_row(x, y + r, bits, SW); continue; }
+#endif
+    for (int32_t i = c.origin; bits; i -= c.step_x, bits >>= 1) {
+      if (bits & 1) { fb_write(buf, i, pen); }
+    }
+  }
+}
@@ -0,0 +1,89 @@
+// indexed_fb.h
+// Optional 4-bit indexed framebuffer (ENABLE_INDEXED_FB).
+// This file is #included inside matrix_clock.ino before framebuffer.h.
+//
+// When enabled, patterns and glyph helpers write colour-slot numbers instead
+// of RGB565 values into ifb[], two pixels per byte (256 bytes for 32×16).
+// ifb[] uses the same raw, unrotated layout as the Protomatter canvas, so
+// every FbCursor index applies to it unchanged.  The slots are resolved to
+// RGB565 through ifb_lut[] once per frame, in present_frame().  Changing the
+// palette or fading the panel therefore only rewrites the 16-entry LUT.
+//
+// Drawing code never names a colour directly; it uses the PEN_* macros
+// below, which are RGB565 values normally and slot numbers in indexed mode.
+
+#define SLOT_BLACK    0   // always black
+#define SLOT_PALETTE  1   // 1-6  : palette[0..5]
+#define SLOT_INK      7   // 7-10 : ink_color[0..3]
+#define SLOT_DATE     11  // date-row grey
+#define SLOT_RED      12  // special overlays (blaze_it)
+#define SLOT_COUNT    16  // 13-15 spare
+
+#if ENABLE_INDEXED_FB
+  #define PEN_PALETTE(i)  (SLOT_PALETTE + (i))
+  #define PEN_INK(d)      (SLOT_INK + (d))
+  #define PEN_DATE        SLOT_DATE
+  #define PEN_RED         SLOT_RED
+#else
+  #define PEN_PALETTE(i)  palette[i]
+  #define PEN_INK(d)      ink_color[d]
+  #define PEN_DATE        lut565(128, 128, 128)
+  #define PEN_RED         RED
+#endif
+#define PEN_BLACK 0
+
+#if ENABLE_INDEXED_FB
+
+uint8_t  ifb[MATRIX_WIDTH * MATRIX_HEIGHT / 2]; // slot per pixel, even pixel in the high nibble
+uint16_t ifb_lut[SLOT_COUNT];                   // slot → RGB565, fade applied
+uint8_t  ifb_fade = 255;                        // 0 (off) – 255 (full)
+
+// Store slot at raw canvas index i.
+inline void ifb_write(int32_t i, uint8_t slot) {
+  uint8_t &b = ifb[i >> 1];
+  b = (i & 1) ? (b & 0xF0) | slot : (b & 0x0F) | (slot << 4);
+}
+
+// Scale an RGB565 colour by level/255 with integer maths.
+uint16_t scale565(uint16_t c, uint8_t level) {
+  uint16_t r = ((c >> 11) * level + 127) / 255;
+  uint16_t g = (((c >> 5) & 0x3F) * level + 127) / 255;
+  uint16_t b = ((c & 0x1F) * level + 127) / 255;
+  return (r << 11) | (g << 5) | b;
+}
+
+// Rebuild ifb_lut[] from the active palette, ink colours and fade level.
+// Call after palette[] or ink_color[] change; costs SLOT_COUNT entries.
+void ifb_update_lut() {
+  uint16_t raw[SLOT_COUNT] = {0};
+  for (uint8_t i = 0; i < 6; i++) { raw[SLOT_PALETTE + i] = palette[i]; }
+  for (uint8_t d = 0; d < 4; d++) { raw[SLOT_INK + d] = ink_color[d]; }
+  raw[SLOT_DATE] = lut565(128, 128, 128);
+  raw[SLOT_RED]  = RED;
+  for (uint8_t s = 0; s < SLOT_COUNT; s++) {
+    ifb_lut[s] = (ifb_fade == 255) ? raw[s] : scale565(raw[s], ifb_fade);
+  }
+}
+
+// Fade the whole panel without re-rendering anything.
+void ifb_set_fade(uint8_t level) {
+  ifb_fade = level;
+  ifb_update_lut();
+}
+
+// Expand the raw rows in rows (bit y = raw row y) of ifb[] into the RGB565
+// canvas through ifb_lut[].  Both buffers share the raw layout, so each row
+// is one linear pass, two pixels per byte.
+void ifb_resolve(uint32_t rows = ALL_ROWS) {
+  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
+    if (!(rows & (1UL << y))) { continue; }
+    uint16_t *out = matrix.getBuffer() + y * MATRIX_WIDTH;
+    const uint8_t *in = ifb + y * (MATRIX_WIDTH / 2);
+    for (uint16_t i = 0; i < MATRIX_WIDTH / 2; i++) {
+      *out++ = ifb_lut[in[i] >> 4];
+      *out++ = ifb_lut[in[i] & 0x0F];
+    }
+  }
+}
+
+#endif // ENABLE_INDEXED_FB
@@ -0,0 +1,69 @@
+// layout.h
+// Panel geometry and clock-face placement, resolved at compile time.
+// This file is #included inside matrix_clock.ino before the matrix object;
+// the sketch defines PANEL_WIDTH, PANEL_HEIGHT, PANEL_CHAIN, FACE_SCALE and
+// the display rotation rot.
+//
+// The clock face is designed on a 32 × 16 grid of face units:
+//
+//   rows  0–9   four 8×10 time digits (time_region)
+//   row   10    black separator line across the panel (separator_region)
+//   rows 11–15  3×5 date text (date_region)
+//
+// One face unit is LAYOUT_SCALE × LAYOUT_SCALE pixels, and the face is
+// centred on the panel.  Drawing code places things with LX()/LY() (face
+// units → pixels) and LS() (a face-unit length), which are constant
+// expressions, so a scaled layout adds no per-pixel work.  The layout
+// assumes a landscape logical panel, so rot must be 0 or 2; the compositor
+// masks and frame damage rows rely on logical rows being raw rows.
+
+// ---- PANEL ----
+
+// Panels chain left to right into one wide canvas.
+#define MATRIX_WIDTH  (PANEL_WIDTH * PANEL_CHAIN)
+#define MATRIX_HEIGHT PANEL_HEIGHT
+
+// Protomatter infers the panel height from the address lines:
+// 2^lines × 2 rows (16 rows → 3 lines, 32 → 4).  64-row panels would need
+// wider frame damage masks.
+#define PANEL_ADDR_LINES (PANEL_HEIGHT == 32 ? 4 : 3)
+
+static_assert(PANEL_HEIGHT == 16 || PANEL_HEIGHT == 32, "PANEL_HEIGHT must be 16 or 32");
+static_assert(MATRIX_WIDTH <= 256, "the ticker ring uses 8-bit column indices");
+static_assert(rot == 0 || rot == 2, "the clock layout needs rotation 0 or 2 (landscape)");
+
+#define ALL_ROWS 0xFFFFFFFFUL // raw canvas row mask (bit y = row y) of every row
+
+// ---- FACE ----
+
+#define FACE_COLS 32 // face units
+#define FACE_ROWS 16
+
+// FACE_SCALE 0 picks the largest integer scale that fits the panel.
+#if FACE_SCALE
+#define LAYOUT_SCALE FACE_SCALE
+#else
+#define LAYOUT_SCALE (MATRIX_WIDTH / FACE_COLS < MATRIX_HEIGHT / FACE_ROWS ? \
+                      MATRIX_WIDTH / FACE_COLS : MATRIX_HEIGHT / FACE_ROWS)
+#endif
+
+static_assert(LAYOUT_SCALE >= 1 && FACE_COLS * LAYOUT_SCALE <= MATRIX_WIDTH &&
+              FACE_ROWS * LAYOUT_SCALE <= MATRIX_HEIGHT,
+              "the 32×16 clock face does not fit the panel at FACE_SCALE");
+static_assert(8 * LAYOUT_SCALE <= 32, "scaled glyph rows must fit in 32 bits");
+
+// Top-left pixel of the face.
+#define LAYOUT_X ((MATRIX_WIDTH  - FACE_COLS * LAYOUT_SCALE) / 2)
+#define LAYOUT_Y ((MATRIX_HEIGHT - FACE_ROWS * LAYOUT_SCALE) / 2)
+
+#define LX(u) (LAYOUT_X + (u) * LAYOUT_SCALE) // face column → pixel x
+#define LY(v) (LAYOUT_Y + (v) * LAYOUT_SCALE) // face row → pixel y
+#define LS(n) ((n) * LAYOUT_SCALE)            // face units → pixels
+
+// ---- REGIONS ----
+
+struct Region { int16_t x, y, w, h; };
+
+constexpr Region time_region      = { LX(0), LY(0),  LS(FACE_COLS), LS(10) };
+constexpr Region separator_region = { 0,     LY(10), MATRIX_WIDTH,  LS(1)  };
+constexpr Region date_region      = { LX(0), LY(11), LS(FACE_COLS), LS(5)  };
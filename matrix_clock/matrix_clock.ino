@@ -5,8 +5,9 @@
 //   Edit the #define block below and re-upload to change the default look.
 //
 // ── RUNTIME CUSTOMISATION ────────────────────────────────────────────────────
-//   Button A (BTN_PALETTE_PIN, default A0): short press → next palette
-//   Button B (BTN_PATTERN_PIN, default A1): short press → next pattern
+//   Button A (BTN_PALETTE_PIN, default D2): short press → next palette
+//   Button B (BTN_PATTERN_PIN, default D3): short press → next pattern
+//   Long press → back to the default; double press (BTN_DOUBLE_MS) → previous
 //   Both buttons are active-LOW.  Wire one leg to the pin, other leg to GND.
 //   The sketch uses INPUT_PULLUP, so no external resistors are needed.
 //
@@ -15,10 +16,14 @@
 //   • 8 animated/static background patterns (cycle at runtime with Button B)
 //   • Per-digit ink colours, driven by the active palette
 //   • Optional colon separator with single-digit-hour shift
-//   • Optional North-American DST detection (adjusts the displayed hour only)
+//   • Optional DST (US/EU/UK rule table, adjusts the displayed time only)
 //   • Adjustable display brightness
+//   • Palette, pattern and brightness restored after a reset (ENABLE_SETTINGS)
+//   • Seconds counted from the DS3231 1 Hz SQW interrupt (ENABLE_SQW_CLOCK)
 //   • TaskScheduler for non-blocking RTC reads, pattern animation,
-//     and button polling (BTN_POLL_MS interval, default 10 ms)
+//     and a fixed-rate render task (TARGET_FPS); the CPU idles between
+//     scheduled events
+//   • Interrupt-driven buttons with long-press and double-press gestures
 //   • Special overlays: blaze_it(), birthday()
 // ─────────────────────────────────────────────────────────────────────────────
 
@@ -26,7 +31,8 @@
 //  COMPILE-TIME CONFIGURATION — edit these before uploading
 // ============================================================
 
-// Starting palette  (1–11).  Cycle at runtime with Button A.
+// Starting palette  (1–11, a row of palettes[] in palettes.h).
+// Cycle at runtime with Button A.
 #define DEFAULT_PALETTE  1
 
 // Starting pattern  (0–7).   Cycle at runtime with Button B.
@@ -37,14 +43,35 @@
 // 1 = enabled, 0 = disabled.
 #define ENABLE_COLON     1
 
-// Detect North-American DST and add one hour to the displayed time while DST
-// is in effect (the RTC itself is never modified).
+// Add one hour to the displayed time while DST is in effect (the RTC itself
+// keeps standard time and is never modified).
 // 1 = enabled, 0 = disabled.
 #define ENABLE_DST       0
 
-// Overall brightness, 0.0 (off) – 1.0 (full).
-// Values below 1.0 reduce colour saturation as well as brightness.
-#define BRIGHTNESS       1.0
+// DST rule from dst_rules.h: DST_US, DST_EU (CET), DST_UK or DST_NONE.
+// Can also be changed at runtime with set_dst_rule().
+#define DST_RULE         DST_US
+
+// Overall brightness, 0 (off) – 255 (full).  Applied through the integer
+// lookup table in color_lut.h, so it can also be changed every frame with
+// update_brightness() for smooth fades.
+#define BRIGHTNESS       255
+
+// Gamma-correct every colour channel (gamma 2.2) in the brightness table.
+// Mid-tones get darker, and dimmed colours keep their hue better.
+// 1 = enabled, 0 = disabled (channels scale linearly, colours as listed).
+#define ENABLE_GAMMA     0
+
+// Follow the room light: sample an analog light sensor on LIGHT_SENSOR_PIN
+// every LIGHT_SAMPLE_MS, smooth it and step the brightness between dim
+// levels and BRIGHTNESS (see auto_brightness.h).  The palette is only
+// rebuilt when the step changes.
+// NOTE: on Feather RP2040 A0 and A1 are free; on Metro M4 all of A0–A5
+//       drive the matrix, so a matrix pin has to move first.
+// 1 = enabled, 0 = disabled (fixed BRIGHTNESS).
+#define ENABLE_AUTO_BRIGHTNESS 0
+#define LIGHT_SENSOR_PIN       A0
+#define LIGHT_SAMPLE_MS        250
 
 // Button pin assignments (active-LOW with INPUT_PULLUP).
 // Change these to match wherever you wire your buttons.
@@ -53,12 +80,105 @@
 #define BTN_PALETTE_PIN  2
 #define BTN_PATTERN_PIN  3
 
-// Minimum milliseconds between button presses (debounce).
-#define BTN_DEBOUNCE_MS  200
-
-// How often (in milliseconds) the scheduler polls the button pins.
-// 10 ms gives responsive feel while staying well inside the debounce window.
-#define BTN_POLL_MS      10
+// Keep time from the DS3231's 1 Hz square-wave output: an interrupt counts
+// seconds and the RTC is read over I²C only at boot and once per minute
+// (instead of every 50 ms).  Wire the DS3231 INT/SQW pin to RTC_SQW_PIN.
+// Without the wire the clock falls back to reading the RTC every 1.5 s.
+// 1 = enabled, 0 = disabled (poll the RTC every 50 ms).
+#define ENABLE_SQW_CLOCK 1
+#define RTC_SQW_PIN      4
+
+// Buttons are read by pin-change interrupts, not polled.
+// Edges within BTN_DEBOUNCE_MS of the previous accepted edge are contact
+// bounce.  Holding a button for BTN_LONG_MS is a long press.  A second press
+// within BTN_DOUBLE_MS of releasing the first is a double press; 0 turns
+// double-press detection off so short presses act on release immediately.
+#define BTN_DEBOUNCE_MS  30
+#define BTN_LONG_MS      800
+#define BTN_DOUBLE_MS    0
+
+// Panel geometry: PANEL_CHAIN panels of PANEL_WIDTH × PANEL_HEIGHT chained
+// left to right.  The 32×16 clock face is scaled by FACE_SCALE and centred
+// (see layout.h); 0 picks the largest scale that fits, e.g. 2 on one
+// 64×32 panel.
+#define PANEL_WIDTH      32
+#define PANEL_HEIGHT     16
+#define PANEL_CHAIN      1
+#define FACE_SCALE       0
+
+// Frame rate of the render task that composites time/date and pushes the
+// frame to the panel.  Animated patterns step on their own face_task
+// interval (PatternInfo in face_task_list.h), not once per frame.
+#define TARGET_FPS       30
+
+// Animate the time digits that change on a new minute instead of snapping:
+// TRANSITION_SLIDE, TRANSITION_ROLL or TRANSITION_DISSOLVE, played over
+// TRANSITION_FRAMES frames at TARGET_FPS (see digit_transition.h).
+// 1 = enabled, 0 = disabled (digits change instantly).
+#define ENABLE_TRANSITIONS 0
+#define DIGIT_TRANSITION   TRANSITION_ROLL
+#define TRANSITION_FRAMES  10
+
+// Static patterns (see PatternInfo in face_task_list.h) are drawn once per
+// change — new minute, palette or pattern — instead of on a timer, so the
+// CPU sleeps in idle_sleep() between changes.  Animated patterns still tick.
+// 1 = enabled, 0 = disabled (every pattern redraws on its face_task timer).
+#define ENABLE_LOW_POWER 1
+
+// Render into a 4-bit indexed framebuffer (256 bytes) and convert to RGB565
+// through the active palette only when a frame is shown.  Palette swaps and
+// fades then cost a 16-entry table update instead of a redraw.
+// 1 = enabled, 0 = disabled (draw RGB565 straight into the canvas).
+#define ENABLE_INDEXED_FB 0
+
+// Compose each frame from a background and 1-bit time/date/overlay layers
+// in a single pass (compositor.h) instead of drawing the digits over the
+// pattern.  Every pixel is written once per frame and overlays can punch
+// out or tint what is below them.
+// 1 = enabled, 0 = disabled (overdraw the canvas directly).
+#define ENABLE_COMPOSITOR 1
+
+// Scroll TICKER_MESSAGE (any length) through the date row instead of showing
+// the date, one pixel column every TICKER_MS.  ticker_start() changes the
+// message at runtime; nullptr goes back to the date.
+// 1 = enabled, 0 = disabled.
+#define ENABLE_TICKER    0
+#define TICKER_MESSAGE   "HELLO FROM THE MATRIX CLOCK"
+#define TICKER_MS        80
+
+// Replace the date row on given days with an overlay (blaze_it, birthday or
+// your own), from a table of { month, day, overlay } entries sorted by date.
+// The table is searched once per day, not per frame.
+// 1 = enabled, 0 = disabled (always show the date).
+#define ENABLE_CALENDAR  0
+#define CALENDAR_ENTRIES \
+  { 4, 20, &blaze_it },  \
+  { 7, 14, &birthday }
+
+// Accept configuration commands on Serial (palette, pattern, brightness,
+// colon, dst, time, status — see serial_cmd.h), polled every CMD_POLL_MS
+// without ever waiting for input.
+// 1 = enabled, 0 = disabled.
+#define ENABLE_SERIAL_CMD 1
+#define CMD_POLL_MS       100
+
+// Remember the palette, pattern and brightness across resets in a
+// wear-levelled log of records in flash — see settings.h.  Changes are
+// saved SETTINGS_SAVE_MS after the last button press or serial command,
+// so stepping through palettes costs one write, not one per press.
+// NOTE: on SAMD51 (Metro M4) this needs the FlashStorage_SAMD library.
+// 1 = enabled, 0 = disabled (always start from the defaults).
+#define ENABLE_SETTINGS  1
+#define SETTINGS_SAVE_MS 3000
+
+// Time the pattern, RTC read, time and date drawing, matrix.show() and the
+// whole render pass with micros() into per-stage histograms, and count
+// scheduler deadlines missed (see profile.h).  The summary is printed by
+// the "profile" serial command and, if PROFILE_REPORT_MS is not 0, every
+// PROFILE_REPORT_MS.
+// 1 = enabled, 0 = disabled (compiled out entirely).
+#define ENABLE_PROFILE    0
+#define PROFILE_REPORT_MS 10000
 
 // ============================================================
 //  LIBRARIES
@@ -68,29 +188,44 @@
 #include <Adafruit_GFX.h>
 #include "RTClib.h"
 #include "font_array.h"
+// Let the scheduler call a sleep method when a pass finds no task due.
+#define _TASK_SLEEP_ON_IDLE_RUN
+#if ENABLE_PROFILE
+// Record each task's start delay and overrun for profile.h.
+#define _TASK_TIMECRITICAL
+#endif
 #include <TaskScheduler.h>
 #include <TaskSchedulerDeclarations.h>
 #include <TaskSchedulerSleepMethods.h>
+#if ENABLE_SETTINGS
+#if defined(ARDUINO_ARCH_SAMD)
+#include <FlashStorage_SAMD.h> // FlashClass: erase and write flash rows
+#else
+#include <hardware/flash.h>    // RP2040: pico-sdk flash_range_erase/program
+#endif
+#endif
 
 // ============================================================
 //  COLOUR ALIASES  (index into colors[] defined below)
 // ============================================================
 
-#define RED       colors[0]
-#define ORANGE    colors[1]
-#define YELLOW    colors[2]
-#define GREEN     colors[3]
-#define BLUE      colors[4]
-#define PURPLE    colors[5]
-#define BLACK     colors[6]
-#define WHITE     colors[7]
-#define GRAY      colors[8]
-#define DUKE_BLUE colors[9]
-#define CYAN      colors[10]
-#define MAGENTA   colors[11]
-#define PURE_RED   matrix.color565(255,0,0)
-#define PURE_GREEN matrix.color565(0,255,0)
-#define PURE_BLUE  matrix.color565(0,0,255)
+enum {
+  C_RED, C_ORANGE, C_YELLOW, C_GREEN, C_BLUE, C_PURPLE,
+  C_BLACK, C_WHITE, C_GRAY, C_DUKE_BLUE, C_CYAN, C_MAGENTA, COLOR_COUNT
+};
+
+#define RED       colors[C_RED]
+#define ORANGE    colors[C_ORANGE]
+#define YELLOW    colors[C_YELLOW]
+#define GREEN     colors[C_GREEN]
+#define BLUE      colors[C_BLUE]
+#define PURPLE    colors[C_PURPLE]
+#define BLACK     colors[C_BLACK]
+#define WHITE     colors[C_WHITE]
+#define GRAY      colors[C_GRAY]
+#define DUKE_BLUE colors[C_DUKE_BLUE]
+#define CYAN      colors[C_CYAN]
+#define MAGENTA   colors[C_MAGENTA]
 
 // ============================================================
 //  HARDWARE PINS
@@ -102,7 +237,7 @@ uint8_t addrPins[] = {17, 18, 19, 20, 21};
 uint8_t clockPin   = 14;
 uint8_t latchPin   = 15;
 uint8_t oePin      = 16;
-int rot = 2; // display rotation (0/1/2/3)
+constexpr int rot = 2; // display rotation: 0 or 2 (the layout is landscape)
 
 // Feather RP2040 — uncomment and comment the block above if using that board:
 // uint8_t rgbPins[]  = {8, 7, 9, 11, 10, 12};
@@ -110,7 +245,7 @@ int rot = 2; // display rotation (0/1/2/3)
 // uint8_t clockPin   = 13;
 // uint8_t latchPin   = 1;
 // uint8_t oePin      = 0;
-// int rot = 0;
+// constexpr int rot = 0;
 
 // ============================================================
 //  MATRIX AND RTC OBJECTS
@@ -119,11 +254,16 @@ int rot = 2; // display rotation (0/1/2/3)
 RTC_DS3231 rtc;
 DateTime now;
 
-// 32 px wide, 4-bit colour depth, single chain, 3 address pins (height=16 inferred)
+// layout.h derives the canvas size (MATRIX_WIDTH × MATRIX_HEIGHT, before
+// rotation), the address-line count and the face placement from PANEL_*.
+#include "layout.h"
+
+// Whole chain width, 4-bit colour depth, one RGB chain, PANEL_ADDR_LINES
+// address pins (panel height inferred)
 Adafruit_Protomatter matrix(
-  32, 4,
+  MATRIX_WIDTH, 4,
   1, rgbPins,
-  3, addrPins,
+  PANEL_ADDR_LINES, addrPins,
   clockPin, latchPin, oePin,
   true  // double-buffering: eliminates flicker and errant-line tearing
 );
@@ -132,20 +272,9 @@ Adafruit_Protomatter matrix(
 //  NAMED COLOUR TABLE
 // ============================================================
 
-uint16_t colors[] = {
-  matrix.color565(255, 0,   0),    //  0  Red
-  matrix.color565(253, 152, 0),    //  1  Orange
-  matrix.color565(255, 255, 0),    //  2  Yellow
-  matrix.color565(51,  254, 0),    //  3  Green
-  matrix.color565(0,   151, 253),  //  4  Blue
-  matrix.color565(102, 51,  253),  //  5  Purple
-  0,                               //  6  Black
-  65535,                           //  7  White
-  matrix.color565(72,  72,  72),   //  8  Gray
-  matrix.color565(28,  33,  168),  //  9  Duke Blue
-  matrix.color565(0,   255, 255),  // 10  Cyan
-  matrix.color565(255, 0,   255),  // 11  Magenta
-};
+// The named colours at the current brightness, rebuilt by
+// update_brightness() from the full-brightness named565[] in palettes.h.
+uint16_t colors[COLOR_COUNT];
 
 // ============================================================
 //  ACTIVE PALETTE & PATTERN STATE
@@ -156,7 +285,7 @@ uint16_t ink_color[4] = {WHITE, WHITE, WHITE, WHITE}; // per-digit foreground co
 int palette_size    = 6;
 int current_palette = DEFAULT_PALETTE;
 int current_pattern = DEFAULT_PATTERN;
-int scroll          = 0;                       // animation counter
+bool show_colon     = ENABLE_COLON;            // colon layout, changeable over serial
 
 // ============================================================
 //  DIGIT AND DATE STATE
@@ -165,10 +294,9 @@ int scroll          = 0;                       // animation counter
 // digits[0..3] = [H-tens, H-ones, M-tens, M-ones] for the display glyphs
 int digits[]     = {1, 0, 2, 3};
 
-// date_array[0..2] = letter indices for 3-char month abbreviation
-// date_array[3]    = tens digit of day-of-month
-// date_array[4]    = ones digit of day-of-month
-int date_array[] = {0, 0, 0, 0, 0};
+// date_text = "MMM DD" as text.h glyph codes, TEXT_END-terminated
+// (filled by access_rtc())
+uint8_t date_text[7];
 
 // ============================================================
 //  TASK SCHEDULER
@@ -176,148 +304,232 @@ int date_array[] = {0, 0, 0, 0, 0};
 
 // Forward declarations needed because tasks reference functions defined below.
 void access_rtc();
-void check_buttons();
+void btn_timeout();
+void render_frame();
+#if ENABLE_AUTO_BRIGHTNESS
+void light_sample();
+#endif
+#if ENABLE_TICKER
+void ticker_tick();
+void render_ticker();
+#endif
+#if ENABLE_CALENDAR
+void calendar_update(const DateTime &local);
+#endif
+#if ENABLE_SERIAL_CMD
+void cmd_poll();
+#endif
+#if ENABLE_SETTINGS
+void settings_flush();
+#endif
+#if ENABLE_PROFILE && PROFILE_REPORT_MS
+void prof_report();
+#endif
+#if ENABLE_TRANSITIONS
+void transition_step();
+void render_digits(uint8_t mask);
+#endif
 
 Scheduler face_scheduler;
 Task face_task(100, -1);                           // background pattern, interval set by switch_pattern()
+#if !ENABLE_SQW_CLOCK
 Task update_digits_task(50, -1, &access_rtc);      // RTC read every 50 ms
-Task btn_task(BTN_POLL_MS, -1, &check_buttons);    // button poll every BTN_POLL_MS
+#endif
+Task btn_timer_task(0, TASK_ONCE, &btn_timeout);   // long/double-press timeouts, armed on demand
+#if ENABLE_TRANSITIONS
+Task transition_task(1000 / TARGET_FPS, TRANSITION_FRAMES, &transition_step); // digit animation frames
+#endif
+Task render_task(1000 / TARGET_FPS, -1, &render_frame); // composite + show at TARGET_FPS
+#if ENABLE_AUTO_BRIGHTNESS
+Task light_task(LIGHT_SAMPLE_MS, -1, &light_sample); // ambient light sample
+#endif
+#if ENABLE_TICKER
+Task ticker_task(TICKER_MS, -1, &ticker_tick);     // date-row ticker, one column per run
+#endif
+#if ENABLE_SERIAL_CMD
+Task cmd_task(CMD_POLL_MS, -1, &cmd_poll);         // serial command input
+#endif
+#if ENABLE_SETTINGS
+Task settings_task(0, TASK_ONCE, &settings_flush); // deferred settings save, armed by settings_touch()
+#endif
+#if ENABLE_PROFILE && PROFILE_REPORT_MS
+Task profile_task(PROFILE_REPORT_MS, -1, &prof_report); // timing summary over Serial
+#endif
+
+// Scheduler idle hook: when no task is due, wait for the next interrupt
+// (SysTick, Protomatter's refresh timer, …) instead of spinning.  Installed
+// with setSleepMethod() because TaskSchedulerSleepMethods.h has no
+// SAMD51/RP2040 implementation.
+void idle_sleep(unsigned long) {
+#if defined(__arm__)
+  __asm__ volatile ("wfi");
+#endif
+}
 
-// face_task_list.h defines all pattern/palette helpers and must be included
-// here so it can reference the variables above.
+// color_lut.h provides the integer brightness/gamma table, palettes.h the
+// colour and palette tables, profile.h the optional stage timers,
+// indexed_fb.h the optional indexed buffer and the PEN_* colours,
+// framebuffer.h direct canvas writes, compositor.h the frame layers,
+// pattern_maps.h the compile-time background maps, face_task_list.h all
+// pattern/palette helpers, glyph.h the glyph blitter, digit_transition.h
+// the digit animations and text.h 3×5 text; they must be included here so
+// they can reference the variables above.
+#include "color_lut.h"
+#include "palettes.h"
+#include "profile.h"
+#include "indexed_fb.h"
+#include "framebuffer.h"
+#include "compositor.h"
+#include "pattern_maps.h"
 #include "face_task_list.h"
+#include "glyph.h"
+#include "digit_transition.h"
+#include "text.h"
+
+// ticker.h scrolls a message through the date row (ENABLE_TICKER).
+#if ENABLE_TICKER
+#include "ticker.h"
+#endif
+
+// sqw_clock.h counts seconds from the RTC square wave (ENABLE_SQW_CLOCK).
+#if ENABLE_SQW_CLOCK
+#include "sqw_clock.h"
+#endif
+
+// frame_damage.h wraps matrix.show() in present_frame(), which skips the
+// bitplane conversion when no pixel changed since the last shown frame.
+#include "frame_damage.h"
+
+// settings.h keeps palette, pattern and brightness in flash (ENABLE_SETTINGS).
+#if ENABLE_SETTINGS
+#include "settings.h"
+#endif
 
 // ============================================================
 //  BUTTON HANDLING
 // ============================================================
 
-unsigned long last_palette_press = 0;
-unsigned long last_pattern_press = 0;
-
-// Poll both buttons; cycle palette or pattern on a debounced falling edge.
-void check_buttons() {
-  unsigned long now_ms = millis();
+// button_events.h queues edges from the button interrupts; buttons_update()
+// turns them into gestures for on_button().
+#include "button_events.h"
 
-  if (digitalRead(BTN_PALETTE_PIN) == LOW &&
-      (now_ms - last_palette_press) > BTN_DEBOUNCE_MS) {
-    last_palette_press = now_ms;
-    change_pal_helper();   // advance current_palette
+// Short press steps forward, double press steps back, long press returns
+// to the compile-time default.
+void on_button(uint8_t button, uint8_t gesture) {
+  if (button == BTN_PALETTE) {
+    if      (gesture == BTN_SHORT)  { change_pal_helper(); }
+    else if (gesture == BTN_DOUBLE) { current_palette = (current_palette == 1) ? PALETTE_COUNT : current_palette - 1; }
+    else                            { current_palette = DEFAULT_PALETTE; }
     change_palette();      // load the new palette into palette[] and ink_color[]
-  }
-
-  if (digitalRead(BTN_PATTERN_PIN) == LOW &&
-      (now_ms - last_pattern_press) > BTN_DEBOUNCE_MS) {
-    last_pattern_press = now_ms;
-    change_pat_helper();              // advance current_pattern
+  } else {
+    if      (gesture == BTN_SHORT)  { change_pat_helper(); }
+    else if (gesture == BTN_DOUBLE) { current_pattern = (current_pattern == 0) ? PATTERN_COUNT - 1 : current_pattern - 1; }
+    else                            { current_pattern = DEFAULT_PATTERN; }
     switch_pattern(current_pattern);  // set face_task callback and interval
   }
+#if ENABLE_SETTINGS
+  settings_touch();
+#endif
 }
 
 // ============================================================
 //  BRIGHTNESS CONTROL  (from lenny_clock)
 // ============================================================
 
-// Scale all named colours by br (0.0 = off, 1.0 = full brightness).
-// Call update_brightness() before change_palette() so palette colours are
-// derived from the already-scaled values.
-void update_brightness(float br) {
-  colors[0]  = matrix.color565(255*br, 0,       0);
-  colors[1]  = matrix.color565(253*br, 152*br,  0);
-  colors[2]  = matrix.color565(255*br, 255*br,  0);
-  colors[3]  = matrix.color565(51*br,  254*br,  0);
-  colors[4]  = matrix.color565(0,      151*br,  253*br);
-  colors[5]  = matrix.color565(102*br, 51*br,   253*br);
-  // colors[6] is always black (0), no scale needed
-  colors[7]  = matrix.color565(255*br, 255*br,  255*br);
-  colors[8]  = matrix.color565(72*br,  72*br,   72*br);
-  colors[9]  = matrix.color565(28*br,  33*br,   168*br);
-  colors[10] = matrix.color565(0,      255*br,  255*br);
-  colors[11] = matrix.color565(255*br, 0,       255*br);
-}
-
-// ============================================================
-//  DST HELPERS  (from ella_clock, conditionally compiled)
-// ============================================================
-
-#if ENABLE_DST
-// Return the DateTime of the second Sunday in March (DST start, North America).
-DateTime calc_dst_start() {
-  DateTime ref = rtc.now();
-  DateTime this_day;
-  int day_of_month = 1;
-  for (int num_sunday = 0; num_sunday < 2; ) {
-    this_day = DateTime(ref.year(), 3, day_of_month);
-    if (!this_day.dayOfTheWeek()) { num_sunday++; }
-    day_of_month++;
-  }
-  return this_day;
-}
-
-// Return the DateTime of the first Sunday in November (DST end, North America).
-DateTime calc_dst_end() {
-  DateTime ref = rtc.now();
-  int day_of_month = 1;
-  DateTime this_day;
-  for (int num_sunday = 0; num_sunday < 1; ) {
-    this_day = DateTime(ref.year(), 11, day_of_month);
-    if (!this_day.dayOfTheWeek()) { num_sunday++; }
-    day_of_month++;
+// Rebuild the brightness table for level (0 = off, 255 = full) and the
+// named colours from it.  Call update_brightness() before change_palette()
+// so palette colours are derived from the new table.  Drops the background
+// cache.
+void update_brightness(uint8_t level) {
+  set_brightness_level(level);
+  for (uint8_t i = 0; i < COLOR_COUNT; i++) {
+    colors[i] = dim565(named565[i]);
   }
-  return this_day;
+  invalidate_background();
 }
 
-// Return true when the current time falls within North-American DST.
-bool check_dst() {
-  DateTime t = rtc.now();
-  return (calc_dst_start() <= t) && (t <= calc_dst_end());
-}
-#endif // ENABLE_DST
+// auto_brightness.h drives update_brightness() from a light sensor.
+#if ENABLE_AUTO_BRIGHTNESS
+#include "auto_brightness.h"
+#endif
 
 // ============================================================
-//  COORDINATE HELPERS
+//  DST RULES  (conditionally compiled)
 // ============================================================
 
-int trans_x(int pos)      { return pos % 8; } // flat index → glyph column (0-7)
-int trans_y(int pos)      { return pos / 8; } // flat index → glyph row   (0-9)
-int trans_x_smol(int pos) { return pos % 3; } // flat index → small glyph column (0-2)
-int trans_y_smol(int pos) { return pos / 3; } // flat index → small glyph row    (0-4)
+// dst_rules.h holds the rule table and caches each year's transitions.
+#if ENABLE_DST
+#include "dst_rules.h"
+#endif
 
 // ============================================================
 //  RTC TASK CALLBACK
 // ============================================================
 
-// Reads the RTC, populates digits[] (12-hour time) and date_array[],
-// and applies a +1-hour DST offset to the displayed hour when ENABLE_DST=true.
+// Reads the RTC, populates digits[] (12-hour time) and date_text[],
+// and applies a +1-hour DST offset to the displayed time when ENABLE_DST=1.
+// With ENABLE_SQW_CLOCK this runs only when sqw_poll() reports a new minute.
 void access_rtc() {
+  PROF_SCOPE(PROF_RTC);
+#if ENABLE_SQW_CLOCK
+  now = sqw_resync();
+#else
   now = rtc.now();
+#endif
 
-  int hour = now.twelveHour(); // 1–12
-
+  // Displayed time: the RTC's standard time, one hour ahead during DST
+  // (so the date also rolls over at local midnight).
+  DateTime local = now;
 #if ENABLE_DST
-  if (check_dst()) {
-    // Advance the displayed hour by one; wrap 12 → 1.
-    hour = (hour % 12) + 1;
-  }
+  if (dst_active(now)) { local = now + TimeSpan(3600); }
 #endif
 
+  // Nothing on the face changes within a minute.
+  static uint32_t shown_minute = 0;
+  uint32_t minute = local.unixtime() / 60;
+  if (minute == shown_minute) { return; }
+#if ENABLE_TRANSITIONS
+  const bool animate = shown_minute != 0; // not on the first reading
+  int before[4] = {digits[0], digits[1], digits[2], digits[3]};
+#endif
+  shown_minute = minute;
+
+  int hour = local.twelveHour(); // 1–12
   if (hour < 10) { digits[0] = 0; digits[1] = hour; }
   else           { digits[0] = 1; digits[1] = hour - 10; }
 
-  digits[2] = now.minute() / 10;
-  digits[3] = now.minute() % 10;
+  digits[2] = local.minute() / 10;
+  digits[3] = local.minute() % 10;
+#if ENABLE_TRANSITIONS
+  if (animate) { transition_start(before); }
+#endif
 
   for (int letter = 0; letter < 3; letter++) {
-    date_array[letter] = months[now.month() - 1][letter];
+    date_text[letter] = months[local.month() - 1][letter];
   }
-  date_array[3] = now.day() / 10;
-  date_array[4] = now.day() % 10;
+  date_text[3] = TEXT_SPACE;
+  date_text[4] = TEXT_DIGIT0 + local.day() / 10;
+  date_text[5] = TEXT_DIGIT0 + local.day() % 10;
+  date_text[6] = TEXT_END;
+
+#if ENABLE_CALENDAR
+  calendar_update(local); // looks the table up only when the day changed
+#endif
+
+  request_redraw();
 }
 
 // ============================================================
 //  DISPLAY: TIME DIGITS
 // ============================================================
 
-// Draw the four time-digit glyphs onto the matrix.
+// Left pixel column of time digit d as display_time() places it.  In the
+// colon layout digit 0 is not drawn and digit 1 moves to face column 4.
+int16_t digit_x(uint8_t d, bool colon) {
+  return (colon && !digits[0] && d == 1) ? LX(4) : LX(d * 8);
+}
+
+// Draw the four time-digit glyphs into time_region (layout.h).
 //
 //  colon — when true AND the leading hour digit is 0, shift the layout
 //           right and draw two colon dots between the hour and minutes.
@@ -325,19 +537,18 @@ void access_rtc() {
 //           when true,  draw the unlit (background) pixels in ink_color[]
 //           (used by background pattern functions to fill around digits).
 void display_time(bool colon, bool bg) {
+  PROF_SCOPE(PROF_TIME);
+  begin_layer(LAYER_TIME, BLEND_REPLACE);
   if (!colon || digits[0]) {
     // Normal four-digit layout (or colon disabled).
     for (int dig = 0; dig < 4; dig++) {
-      for (int i = 0; i < 80; i++) {
-        if ((num[digits[dig]][i] && !bg) || (!num[digits[dig]][i] && bg)) {
-          matrix.drawPixel(trans_x(i) + dig * 8, trans_y(i), ink_color[dig]);
-        }
-      }
+      drawGlyph<8, 10>(digit_x(dig, colon), LY(0), digit_rows(dig), PEN_INK(dig), bg);
     }
+    end_layer();
     return;
   }
 
-  // Single-digit hour with colon — shifted layout:
+  // Single-digit hour with colon — shifted layout (face columns):
   //   cols  0-3  : blank / leading space
   //   cols  4-11 : hour digit
   //   cols 12-15 : colon dots
@@ -346,45 +557,27 @@ void display_time(bool colon, bool bg) {
 
   if (bg) {
     // Background pixels (the "holes" around each glyph)
-    matrix.fillRect(0, 0, 4, 10, 0);
-    for (int i = 0; i < 80; i++) {
-      if (!num[digits[1]][i]) {
-        matrix.drawPixel(trans_x(i) + 4, trans_y(i), ink_color[1]);
-      }
-    }
+    fb_fill_rect(LX(0), LY(0), LS(4), LS(10), PEN_BLACK);
+    drawGlyph<8, 10>(LX(4), LY(0), digit_rows(1), PEN_INK(1), true);
     // Clear colon column backgrounds
-    matrix.fillRect(12, 0, 4, 2, 0);
-    matrix.fillRect(12, 8, 4, 2, 0);
-    matrix.fillRect(12, 0, 1, 10, 0);
-    matrix.fillRect(12, 4, 4, 2, 0);
-    matrix.fillRect(15, 0, 1, 10, 0);
-    for (int i = 0; i < 80; i++) {
-      if (!num[digits[2]][i]) {
-        matrix.drawPixel(trans_x(i) + 16, trans_y(i), ink_color[2]);
-      }
-      if (!num[digits[3]][i]) {
-        matrix.drawPixel(trans_x(i) + 24, trans_y(i), ink_color[3]);
-      }
-    }
+    fb_fill_rect(LX(12), LY(0), LS(4), LS(2), PEN_BLACK);
+    fb_fill_rect(LX(12), LY(8), LS(4), LS(2), PEN_BLACK);
+    fb_fill_rect(LX(12), LY(0), LS(1), LS(10), PEN_BLACK);
+    fb_fill_rect(LX(12), LY(4), LS(4), LS(2), PEN_BLACK);
+    fb_fill_rect(LX(15), LY(0), LS(1), LS(10), PEN_BLACK);
+    drawGlyph<8, 10>(LX(16), LY(0), digit_rows(2), PEN_INK(2), true);
+    drawGlyph<8, 10>(LX(24), LY(0), digit_rows(3), PEN_INK(3), true);
+    end_layer();
     return;
   }
 
   // Foreground pixels (the lit segments and colon dots)
-  for (int i = 0; i < 80; i++) {
-    if (num[digits[1]][i]) {
-      matrix.drawPixel(trans_x(i) + 4, trans_y(i), ink_color[1]);
-    }
-  }
-  matrix.fillRect(13, 2, 2, 2, ink_color[1]); // upper colon dot
-  matrix.fillRect(13, 6, 2, 2, ink_color[1]); // lower colon dot
-  for (int i = 0; i < 80; i++) {
-    if (num[digits[2]][i]) {
-      matrix.drawPixel(trans_x(i) + 16, trans_y(i), ink_color[2]);
-    }
-    if (num[digits[3]][i]) {
-      matrix.drawPixel(trans_x(i) + 24, trans_y(i), ink_color[3]);
-    }
-  }
+  drawGlyph<8, 10>(LX(4), LY(0), digit_rows(1), PEN_INK(1));
+  fb_fill_rect(LX(13), LY(2), LS(2), LS(2), PEN_INK(1)); // upper colon dot
+  fb_fill_rect(LX(13), LY(6), LS(2), LS(2), PEN_INK(1)); // lower colon dot
+  drawGlyph<8, 10>(LX(16), LY(0), digit_rows(2), PEN_INK(2));
+  drawGlyph<8, 10>(LX(24), LY(0), digit_rows(3), PEN_INK(3));
+  end_layer();
 }
 
 // ============================================================
@@ -392,66 +585,56 @@ void display_time(bool colon, bool bg) {
 // ============================================================
 
 // Draw the 3-char month abbreviation and 2-digit day in the bottom rows
-// using 3×5 pixel small glyphs.
-void display_date(uint16_t color) {
-  // Month abbreviation: three letter glyphs starting at x=10, y=11
-  for (int place = 0; place < 3; place++) {
-    for (int i = 0; i < 15; i++) {
-      if (letters[date_array[place]][i]) {
-        matrix.drawPixel(10 + trans_x_smol(i) + place * 4, trans_y_smol(i) + 11, color);
-      }
-    }
-  }
-  // Day number: two digit glyphs after the month abbreviation
-  for (int place = 3; place < 5; place++) {
-    for (int i = 0; i < 15; i++) {
-      if (small_num[date_array[place]][i]) {
-        matrix.drawPixel(11 + trans_x_smol(i) + place * 4, trans_y_smol(i) + 11, color);
-      }
-    }
-  }
+// using 3×5 pixel small glyphs, in pen (normally PEN_DATE).
+void display_date(uint16_t pen) {
+  PROF_SCOPE(PROF_DATE);
+  begin_layer(LAYER_DATE, BLEND_REPLACE);
+  draw_codes(date_region.x + LS(10), date_region.y, date_text, pen);
+  end_layer();
 }
 
 // ============================================================
 //  SPECIAL TEXT OVERLAYS  (from lenny_clock)
 // ============================================================
 
-// Letter indices into the letters[] glyph table (A=0, B=1, …, Z=25)
-int blaze_num[]    = {1, 11, 0, 25, 4, 8, 19};   // B L A Z E I T
-int birthday_num[] = {1, 8, 17, 19, 7, 3, 0, 24}; // B I R T H D A Y
+// Overlay strings, converted to glyph codes at compile time
+constexpr uint8_t blaze_text[]    = TEXT("BLAZE IT");
+constexpr uint8_t birthday_text[] = TEXT("BIRTHDAY");
 
 // Draw "BLAZE IT" in red across the bottom five rows.
 // Call instead of display_date() on April 20 if desired.
 void blaze_it() {
-  for (int place = 0; place < 5; place++) {
-    for (int i = 0; i < 15; i++) {
-      if (letters[blaze_num[place]][i]) {
-        matrix.drawPixel(1 + trans_x_smol(i) + place * 4, trans_y_smol(i) + 11, RED);
-      }
-    }
-  }
-  for (int place = 5; place < 7; place++) {
-    for (int i = 0; i < 15; i++) {
-      if (letters[blaze_num[place]][i]) {
-        matrix.drawPixel(2 + trans_x_smol(i) + place * 4, trans_y_smol(i) + 11, RED);
-      }
-    }
-  }
+  begin_layer(LAYER_OVERLAY, BLEND_REPLACE);
+  draw_codes(date_region.x + LS(1), date_region.y, blaze_text, PEN_RED);
+  end_layer();
 }
 
 // Draw "BIRTHDAY" in the bottom rows by blanking the non-letter pixels.
 // Call instead of display_date() to replace the date with a birthday message.
 void birthday() {
-  for (int place = 0; place < 8; place++) {
-    for (int i = 0; i < 15; i++) {
-      if (!letters[birthday_num[place]][i]) {
-        matrix.drawPixel(1 + trans_x_smol(i) + place * 4, trans_y_smol(i) + 11, 0);
-      }
-    }
-    matrix.drawFastVLine(place * 4, 11, 5, 0);
-  }
+  begin_layer(LAYER_OVERLAY, BLEND_PUNCH);
+  draw_codes(date_region.x + LS(1), date_region.y, birthday_text, PEN_BLACK, TEXT_PUNCH);
+  end_layer();
 }
 
+// ============================================================
+//  DATED OVERLAYS  (conditionally compiled)
+// ============================================================
+
+// calendar.h picks today's overlay from CALENDAR_ENTRIES.
+#if ENABLE_CALENDAR
+#include "calendar.h"
+#endif
+
+// ============================================================
+//  SERIAL COMMANDS  (conditionally compiled)
+// ============================================================
+
+// serial_cmd.h parses configuration commands from Serial.
+#if ENABLE_SERIAL_CMD
+#include "serial_cmd.h"
+#endif
+
 // ============================================================
 //  SETUP
 // ============================================================
@@ -460,12 +643,16 @@ void setup(void) {
   Serial.begin(9600);
   rtc.begin();
 
-  // Configure buttons as active-LOW inputs (internal pull-up, no resistors needed)
-  pinMode(BTN_PALETTE_PIN, INPUT_PULLUP);
-  pinMode(BTN_PATTERN_PIN, INPUT_PULLUP);
+  // Buttons are active-LOW inputs (internal pull-up, no resistors needed)
+  // reported through pin-change interrupts.
+  buttons_begin();
 
   delay(100);
+#if ENABLE_SQW_CLOCK
+  now = sqw_begin();   // enable the 1 Hz output and start counting seconds
+#else
   now = rtc.now();
+#endif
 
   // Initialise the Protomatter matrix
   ProtomatterStatus status = matrix.begin();
@@ -478,51 +665,187 @@ void setup(void) {
     for (;;);
   }
 
-  // Apply compile-time brightness (rebuilds colors[] before change_palette()).
+  // Restore the saved palette, pattern and brightness (ENABLE_SETTINGS);
+  // anything missing or invalid keeps its compile-time default.
+#if ENABLE_SETTINGS
+  settings_load();
+#endif
+
+  // Apply the starting brightness (rebuilds colors[] before change_palette()):
+  // from the light sensor with ENABLE_AUTO_BRIGHTNESS, else the saved level
+  // or BRIGHTNESS.
+#if ENABLE_AUTO_BRIGHTNESS
+  update_brightness(light_begin());
+#elif ENABLE_SETTINGS
+  update_brightness(saved_brightness);
+#else
   update_brightness(BRIGHTNESS);
+#endif
 
-  // Seed the RTC state so digits[] and date_array[] are valid before first draw.
+  // Seed the RTC state so digits[] and date_text[] are valid before first draw.
   access_rtc();
 
-  // Load the compile-time default palette and pattern.
-  current_palette = DEFAULT_PALETTE;
+  // Load the starting palette and pattern (the defaults unless restored).
   change_palette();
-  current_pattern = DEFAULT_PATTERN;
-  switch_pattern(DEFAULT_PATTERN);
+  switch_pattern(current_pattern);
 
   // Register and enable the scheduler tasks.
-  face_scheduler.addTask(face_task);
+#if !ENABLE_SQW_CLOCK
   face_scheduler.addTask(update_digits_task);
-  face_scheduler.addTask(btn_task);
+#endif
+  face_scheduler.addTask(btn_timer_task); // enabled by buttons_update() when needed
+#if ENABLE_AUTO_BRIGHTNESS
+  face_scheduler.addTask(light_task);
+#endif
+#if ENABLE_TICKER
+  face_scheduler.addTask(ticker_task);
+#endif
+#if ENABLE_SERIAL_CMD
+  face_scheduler.addTask(cmd_task);
+#endif
+#if ENABLE_SETTINGS
+  face_scheduler.addTask(settings_task); // enabled by settings_touch()
+#endif
+#if ENABLE_PROFILE && PROFILE_REPORT_MS
+  face_scheduler.addTask(profile_task);
+  profile_task.enableDelayed(); // first report after one period
+#endif
+#if ENABLE_TRANSITIONS
+  face_scheduler.addTask(transition_task); // started by access_rtc() on a new minute
+#endif
+  // Added last, so a redraw requested by any task above is drawn in the
+  // same pass, and the pattern before the composite.
+  face_scheduler.addTask(face_task);
+  face_scheduler.addTask(render_task);
   face_task.enable();
+#if !ENABLE_SQW_CLOCK
   update_digits_task.enable();
-  btn_task.enable();
+#endif
+  render_task.enable();
+#if ENABLE_AUTO_BRIGHTNESS
+  light_task.enable();
+#endif
+#if ENABLE_SERIAL_CMD
+  cmd_task.enable();
+#endif
+#if ENABLE_TICKER
+  ticker_start(TICKER_MESSAGE);
+#endif
 
-  matrix.show();
+  face_scheduler.setSleepMethod(&idle_sleep);
 }
 
 // ============================================================
-//  LOOP
+//  RENDER TASK CALLBACK
 // ============================================================
 
-void loop() {
-  // Run all scheduled tasks: button poll, background pattern draw, RTC refresh.
-  face_scheduler.execute();
+// Composite one frame at TARGET_FPS: overlay time and date on whatever the
+// background pattern last drew, then push it to the panel.  With
+// ENABLE_COMPOSITOR the display helpers fill layers and compose_frame()
+// writes the canvas; otherwise they draw over it directly.
+void render_frame() {
+  PROF_TASK(PROF_RENDER, render_task);
+  layers_clear();
 
   // Overlay the time digits in ink_color[] on top of the background.
-  display_time(ENABLE_COLON, false);
+  display_time(show_colon, false);
 
   // Thin black separator line between the time and date rows.
-  matrix.drawFastHLine(0, 10, 32, 0);
+  begin_layer(LAYER_SEPARATOR, BLEND_PUNCH);
+  fb_fill_rect(separator_region.x, separator_region.y, separator_region.w, separator_region.h,
+               PEN_BLACK);
+  end_layer();
+
+  // Date in neutral grey, unless the ticker is running or the calendar has
+  // an overlay for today (ENABLE_CALENDAR).
+#if ENABLE_TICKER
+  if (ticker_msg) {
+    begin_layer(LAYER_DATE, BLEND_REPLACE);
+    ticker_draw(PEN_DATE);
+    end_layer();
+  } else
+#endif
+#if ENABLE_CALENDAR
+  if (calendar_overlay) { calendar_overlay(); } else
+#endif
+  display_date(PEN_DATE);
 
-  // Date in neutral grey.  Replace this call with blaze_it() or birthday()
-  // if you want a special overlay on a particular day.
-  display_date(matrix.color565(128, 128, 128));
+  // Merge background and layers into the canvas (compositor only).
+  compose_frame();
 
-  // Push the frame buffer to the physical LEDs.
-  matrix.show();
+  // Push the frame buffer to the physical LEDs (skipped if nothing changed).
+  present_frame();
+}
 
-  // Advance the scroll counter used by animated patterns.
-  scroll++;
-  if (scroll == 100) { scroll = 0; }
+#if ENABLE_TRANSITIONS
+// Redraw just the time digits in mask (bit d = digit d) for one transition
+// frame.  On a static face the background, separator and date are already
+// in place, so each 8×10 cell is recomposed over the background (or the
+// background is restored under it), and only the time rows are rehashed.
+// Animated faces, and a frame whose full redraw is still pending, leave it
+// to render_task.
+void render_digits(uint8_t mask) {
+#if ENABLE_LOW_POWER
+  if (face_animated || render_task.isEnabled()) { return; }
+  for (uint8_t d = 0; d < 4; d++) {
+    if (!(mask & (1 << d))) { continue; }
+    const int16_t x = digit_x(d, show_colon);
+#if ENABLE_COMPOSITOR
+    layer_clear_rect(LAYER_TIME, x, LY(0), LS(8), LS(10));
+    begin_layer(LAYER_TIME, BLEND_REPLACE);
+    drawGlyph<8, 10>(x, LY(0), digit_rows(d), PEN_INK(d));
+    end_layer();
+    compose_rect(x, LY(0), LS(8), LS(10));
+#else
+    fb_restore_rect(x, LY(0), LS(8), LS(10));
+    drawGlyph<8, 10>(x, LY(0), digit_rows(d), PEN_INK(d));
+#endif
+  }
+  present_frame(fb_raw_rows(time_region.y, time_region.h));
+#endif
+}
+#endif
+
+#if ENABLE_TICKER
+// Redraw the ticker strip (the date rows, full panel width) after
+// ticker_tick() shifted in a column.  As in render_digits(), a static face
+// only has the strip recomposed over the background (or the background
+// restored under it) and only the date rows rehashed; animated faces, and
+// a frame whose full redraw is still pending, leave it to render_task.
+void render_ticker() {
+#if ENABLE_LOW_POWER
+  if (face_animated || render_task.isEnabled()) { return; }
+#if ENABLE_COMPOSITOR
+  layer_clear_rect(LAYER_DATE, 0, date_region.y, MATRIX_WIDTH, date_region.h);
+  begin_layer(LAYER_DATE, BLEND_REPLACE);
+  ticker_draw(PEN_DATE);
+  end_layer();
+  compose_rect(0, date_region.y, MATRIX_WIDTH, date_region.h);
+#else
+  fb_restore_rect(0, date_region.y, MATRIX_WIDTH, date_region.h);
+  ticker_draw(PEN_DATE);
+#endif
+  present_frame(fb_raw_rows(date_region.y, date_region.h));
+#endif
+}
+#endif
+
+// ============================================================
+//  LOOP
+// ============================================================
+
+void loop() {
+  // Handle button edges queued by the interrupts since the last pass.
+  buttons_update();
+
+#if ENABLE_SQW_CLOCK
+  // Fold in SQW seconds (the 1 Hz interrupt wakes the CPU for this pass);
+  // the RTC is only read, and the face redrawn, when a minute rolls over.
+  if (sqw_poll()) { access_rtc(); }
+#endif
+
+  // Run whichever tasks are due (background pattern, button timeouts,
+  // render); the scheduler sleeps in idle_sleep() otherwise, and any
+  // interrupt (including a button edge) wakes it for another pass.
+  face_scheduler.execute();
 }
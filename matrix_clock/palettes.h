@@ -0,0 +1,69 @@
+// palettes.h
+// Named colours and the palette table, resolved to RGB565 at compile time.
+// This file is #included inside matrix_clock.ino after color_lut.h; the
+// sketch declares the C_* colour indices and colors[].
+//
+// Everything here is constexpr, so it lives in flash and costs nothing at
+// start-up.  Only the active palette is dimmed, by change_palette() through
+// dim565(), and the named colours by update_brightness().
+//
+// To add a palette, add a row to palettes[]: button A, the serial palette
+// command and the settings store all take their range from PALETTE_COUNT.
+
+// Full-brightness RGB565 of each named colour, indexed by C_*.
+constexpr uint16_t named565[] = {
+  rgb565(255, 0,   0),    // C_RED
+  rgb565(253, 152, 0),    // C_ORANGE
+  rgb565(255, 255, 0),    // C_YELLOW
+  rgb565(51,  254, 0),    // C_GREEN
+  rgb565(0,   151, 253),  // C_BLUE
+  rgb565(102, 51,  253),  // C_PURPLE
+  rgb565(0,   0,   0),    // C_BLACK
+  rgb565(255, 255, 255),  // C_WHITE
+  rgb565(72,  72,  72),   // C_GRAY
+  rgb565(28,  33,  168),  // C_DUKE_BLUE
+  rgb565(0,   255, 255),  // C_CYAN
+  rgb565(255, 0,   255),  // C_MAGENTA
+};
+static_assert(sizeof(named565) / sizeof(named565[0]) == COLOR_COUNT,
+              "named565[] needs one entry per C_* colour");
+
+struct PaletteDef {
+  const char *name;
+  uint8_t     size;       // background colours used, 4 or 6
+  uint16_t    colors[6];  // background, full-brightness RGB565
+  uint16_t    ink[4];     // per-digit ink, full-brightness RGB565
+};
+
+// c is pasted onto C_, never expanded, so RED here is not the colors[] alias.
+#define N(c)      named565[C_##c]
+#define INK4(c)   { named565[C_##c], named565[C_##c], named565[C_##c], named565[C_##c] }
+
+// Numbered from 1 (palette 1 is palettes[0]).
+constexpr PaletteDef palettes[] = {
+  { "Rainbow",          6, { N(RED), N(ORANGE), N(YELLOW), N(GREEN), N(BLUE), N(PURPLE) }, INK4(BLACK) },
+  { "Rainbow white",    6, { N(RED), N(ORANGE), N(YELLOW), N(GREEN), N(BLUE), N(PURPLE) }, INK4(WHITE) },
+  { "Red/blue/yellow",  4, { N(RED), N(BLUE), N(YELLOW), N(WHITE) },                       INK4(BLACK) },
+  { "Pure RGB",         4, { rgb565(255, 0, 0), rgb565(0, 255, 0), rgb565(0, 0, 255), N(WHITE) }, INK4(BLACK) },
+  { "CMYK",             4, { N(CYAN), N(MAGENTA), N(YELLOW), N(BLACK) },                   INK4(WHITE) },
+  { "Pastel",           6, { rgb565(204, 232, 219), rgb565(193, 212, 227), rgb565(190, 180, 214),
+                             rgb565(250, 218, 226), rgb565(248, 179, 202), rgb565(204, 151, 193) },
+                                                                                           INK4(BLACK) },
+  { "Wilderness",       6, { rgb565(63, 53, 53),    rgb565(169, 92, 74),   rgb565(214, 175, 116),
+                             rgb565(135, 163, 100), rgb565(74, 138, 118),  rgb565(61, 80, 112) },
+                                                                                           INK4(BLACK) },
+  { "Duke",             4, { N(DUKE_BLUE), N(GRAY), N(WHITE), N(DUKE_BLUE) },              INK4(BLACK) },
+  { "Purple/yellow",    4, { N(PURPLE), N(YELLOW), N(PURPLE), N(YELLOW) },
+                           { N(YELLOW), N(PURPLE), N(YELLOW), N(PURPLE) } },
+  { "Orange/cyan",      4, { N(ORANGE), N(BLACK), N(BLUE), N(BLACK) },
+                           { N(BLUE), N(ORANGE), N(ORANGE), N(BLUE) } },
+  { "Monochrome",       4, { N(BLACK), N(WHITE), N(BLACK), N(WHITE) },                     INK4(GRAY) },
+};
+
+#undef N
+#undef INK4
+
+#define PALETTE_COUNT ((int)(sizeof(palettes) / sizeof(palettes[0])))
+
+static_assert(DEFAULT_PALETTE >= 1 && DEFAULT_PALETTE <= PALETTE_COUNT,
+              "DEFAULT_PALETTE must be 1 … PALETTE_COUNT");
@@ -0,0 +1,119 @@
+// pattern_maps.h
+// Background patterns expressed as constant pixel → palette-index maps.
+// This file is #included inside matrix_clock.ino after framebuffer.h.
+//
+// Every geometric pattern is a pure function of (x, y) and the palette size,
+// so instead of rasterising lines and rectangles each tick, the index of
+// every pixel is computed once at compile time and stored in flash.  A frame
+// is then one linear pass: palette[(map + phase) % palette_size].
+//
+// Each map set holds two maps, [0] for 4-colour and [1] for 6-colour
+// palettes, with the indices already reduced modulo the palette size so the
+// per-pixel work is an add and a compare.  MAP_BLANK pixels are painted black.
+
+#define MAP_BLANK 0xFF
+
+// Per-pixel formulas, at(u, v, n) for an n-colour palette, in face units
+// (layout.h): u and v are the face column and row a pixel falls in, and
+// may run past the 32 × 16 face on a larger panel.  Coordinates outside a
+// pattern's area give MAP_BLANK.
+
+// Floor division and a non-negative modulo, for pixels left of or above
+// the face.
+constexpr int pm_fdiv(int a, int b) { return a >= 0 ? a / b : -((b - 1 - a) / b); }
+constexpr int pm_mod(int a, int n)  { return (a % n + n) % n; }
+
+// Diagonal stripes (u + v), 1 unit wide for 6 colours, 2 for 4.  Reversed
+// so a growing phase moves the stripes the same way the old drawLine
+// version did.
+struct PmScrollDiagonal {
+  static constexpr int at(int u, int v, int n) { return pm_mod(-pm_fdiv(u + v, n == 6 ? 1 : 2), n); }
+};
+// Static diagonal stripes, 2 units wide.
+struct PmDiagonal {
+  static constexpr int at(int u, int v, int n) { return pm_mod(pm_fdiv(u + v, 2), n); }
+};
+// One solid block per palette colour across the clock rows (0-10); the
+// end blocks stretch to the panel edges.
+struct PmBlocks {
+  static constexpr int block(int u, int n) {
+    return n == 4 ? u / 8 : u < 6 ? 0 : u < 11 ? 1 : u < 16 ? 2 : u < 21 ? 3 : u < 26 ? 4 : 5;
+  }
+  static constexpr int at(int u, int v, int n) {
+    return v < 0 || v > 10 ? MAP_BLANK : block(u < 0 ? 0 : u > 31 ? 31 : u, n);
+  }
+};
+// Thin horizontal stripes over rows 0-11.
+struct PmHThin {
+  static constexpr int at(int u, int v, int n) { return v < 0 || v > 11 ? MAP_BLANK : v % n; }
+};
+// Thick horizontal bands dividing rows 0-11 evenly between the colours.
+struct PmHThick {
+  static constexpr int at(int u, int v, int n) { return v < 0 || v > 11 ? MAP_BLANK : v / (12 / n); }
+};
+// Thin vertical stripes over rows 0-10.
+struct PmVThin {
+  static constexpr int at(int u, int v, int n) { return v < 0 || v > 10 ? MAP_BLANK : pm_mod(u, n); }
+};
+// Thick vertical stripes (same band width as H-thick) over rows 0-10.
+struct PmVThick {
+  static constexpr int at(int u, int v, int n) {
+    return v < 0 || v > 10 ? MAP_BLANK : pm_mod(pm_fdiv(u, 12 / n), n);
+  }
+};
+
+struct PatternRow { uint8_t px[MATRIX_WIDTH]; };
+struct PatternMap { PatternRow row[MATRIX_HEIGHT]; };
+
+// Expand a formula into a MATRIX_HEIGHT × MATRIX_WIDTH initialiser: PmRange<N>
+// is the index pack 0 … N-1, expanded once for rows and once per row for
+// columns.
+template <int... I> struct PmSeq {};
+template <int N, int... I> struct PmRange : PmRange<N - 1, N - 1, I...> {};
+template <int... I> struct PmRange<0, I...> { typedef PmSeq<I...> type; };
+
+template <class F, int N, int Y, int... X>
+constexpr PatternRow pm_row(PmSeq<X...>) {
+  return PatternRow{{ (uint8_t)F::at(pm_fdiv(X - LAYOUT_X, LAYOUT_SCALE),
+                                     pm_fdiv(Y - LAYOUT_Y, LAYOUT_SCALE), N)... }};
+}
+template <class F, int N, int... Y>
+constexpr PatternMap pm_map(PmSeq<Y...>) {
+  return PatternMap{{ pm_row<F, N, Y>(typename PmRange<MATRIX_WIDTH>::type())... }};
+}
+
+#define PM_SET(F) { pm_map<F, 4>(PmRange<MATRIX_HEIGHT>::type()), \
+                    pm_map<F, 6>(PmRange<MATRIX_HEIGHT>::type()) }
+
+constexpr PatternMap pm_scroll_diagonal[2] = PM_SET(PmScrollDiagonal);
+constexpr PatternMap pm_diagonal[2]        = PM_SET(PmDiagonal);
+constexpr PatternMap pm_blocks[2]          = PM_SET(PmBlocks);
+constexpr PatternMap pm_h_thin[2]          = PM_SET(PmHThin);
+constexpr PatternMap pm_h_thick[2]         = PM_SET(PmHThick);
+constexpr PatternMap pm_v_thin[2]          = PM_SET(PmVThin);
+constexpr PatternMap pm_v_thick[2]         = PM_SET(PmVThick);
+
+#undef PM_SET
+
+// Pick the 4- or 6-colour map of a set for the active palette.
+#define PM_FOR_PALETTE(set) (set[palette_size == 6])
+
+// Paint the canvas from a pattern map.  Each pixel shows
+// palette[(map + phase) % palette_size]; phase must be < palette_size.
+void fill_from_map(const PatternMap &map, uint8_t phase) {
+  // Palette pens repeated twice, so map + phase never needs a modulo.
+  uint16_t lut[12];
+  for (uint8_t i = 0; i < 2 * palette_size; i++) {
+    lut[i] = PEN_PALETTE(i < palette_size ? i : i - palette_size);
+  }
+  uint16_t *buf = fb_surface();
+  const int16_t w = min<int16_t>(matrix.width(), MATRIX_WIDTH);
+  const int16_t h = min<int16_t>(matrix.height(), MATRIX_HEIGHT);
+  for (int16_t y = 0; y < h; y++) {
+    FbCursor c = fb_cursor(0, y);
+    const uint8_t *m = map.row[y].px;
+    for (int16_t x = 0; x < w; x++, c.origin += c.step_x) {
+      fb_write(buf, c.origin, (m[x] == MAP_BLANK) ? PEN_BLACK : lut[m[x] + phase]);
+    }
+  }
+}
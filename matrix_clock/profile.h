@@ -0,0 +1,95 @@
+// profile.h
+// Per-stage timing histograms (ENABLE_PROFILE).
+// This file is #included inside matrix_clock.ino before framebuffer.h; the
+// sketch defines _TASK_TIMECRITICAL when the flag is on and provides
+// profile_task (callback prof_report, every PROFILE_REPORT_MS).
+//
+// PROF_SCOPE(stage) at the top of a function records the micros() it took
+// into that stage's histogram.  PROF_TASK(stage, task) additionally checks
+// the scheduler's view of a task run:
+//   missed — the run started so late the next one was already due
+//   over   — the run took longer than the task's interval
+// prof_report() prints one line per stage and starts a new period.  With
+// the flag off, both macros expand to nothing.
+
+enum { PROF_FACE, PROF_RTC, PROF_TIME, PROF_DATE, PROF_SHOW, PROF_RENDER, PROF_STAGE_COUNT };
+
+#if ENABLE_PROFILE
+
+// Bucket b counts durations below PROF_BUCKET0_US << b; the last bucket
+// takes everything longer.
+#define PROF_BUCKETS    10
+#define PROF_BUCKET0_US 16
+
+struct ProfStage {
+  uint16_t hist[PROF_BUCKETS]; // saturating counts
+  uint32_t runs;
+  uint32_t max_us;
+  uint16_t missed;             // PROF_TASK stages only
+  uint16_t over;
+};
+
+ProfStage prof_stages[PROF_STAGE_COUNT];
+const char *const prof_names[PROF_STAGE_COUNT] = {"face", "rtc", "time", "date", "show", "render"};
+
+void prof_record(uint8_t stage, uint32_t us) {
+  ProfStage &s = prof_stages[stage];
+  uint8_t b = 0;
+  while (b < PROF_BUCKETS - 1 && us >= ((uint32_t)PROF_BUCKET0_US << b)) { b++; }
+  if (s.hist[b] != 0xFFFF) { s.hist[b]++; }
+  s.runs++;
+  if (us > s.max_us) { s.max_us = us; }
+}
+
+// Times one scope; the destructor runs on every return path.
+struct ProfScope {
+  uint8_t  stage;
+  uint32_t start;
+  explicit ProfScope(uint8_t s) : stage(s), start(micros()) {}
+  ~ProfScope() { prof_record(stage, micros() - start); }
+};
+
+struct ProfTaskScope : ProfScope {
+  Task &task;
+  ProfTaskScope(uint8_t s, Task &t) : ProfScope(s), task(t) {}
+  ~ProfTaskScope() {
+    ProfStage &s = prof_stages[stage];
+    if (task.getOverrun() < 0) { s.missed++; }
+    if (micros() - start > task.getInterval() * 1000UL) { s.over++; }
+  }
+};
+
+#define PROF_SCOPE(stage)      ProfScope prof_scope_(stage)
+#define PROF_TASK(stage, task) ProfTaskScope prof_scope_(stage, task)
+
+// Print the histograms collected since the last report, then clear them.
+//   prof us <16 <32 … >=4096
+//   prof face n 120 max 84 missed 0 over 0 | 0 3 117 0 …
+void prof_report() {
+  Serial.print("prof us");
+  for (uint8_t b = 0; b < PROF_BUCKETS - 1; b++) {
+    Serial.print(" <"); Serial.print((unsigned long)PROF_BUCKET0_US << b);
+  }
+  Serial.print(" >="); Serial.println((unsigned long)PROF_BUCKET0_US << (PROF_BUCKETS - 2));
+  for (uint8_t i = 0; i < PROF_STAGE_COUNT; i++) {
+    const ProfStage &s = prof_stages[i];
+    Serial.print("prof ");      Serial.print(prof_names[i]);
+    Serial.print(" n ");        Serial.print((unsigned long)s.runs);
+    Serial.print(" max ");      Serial.print((unsigned long)s.max_us);
+    Serial.print(" missed ");   Serial.print((unsigned long)s.missed);
+    Serial.print(" over ");     Serial.print((unsigned long)s.over);
+    Serial.print(" |");
+    for (uint8_t b = 0; b < PROF_BUCKETS; b++) {
+      Serial.print(" "); Serial.print((unsigned long)s.hist[b]);
+    }
+    Serial.println();
+  }
+  memset(prof_stages, 0, sizeof(prof_stages));
+}
+
+#else // !ENABLE_PROFILE
+
+#define PROF_SCOPE(stage)
+#define PROF_TASK(stage, task)
+
+#endif // ENABLE_PROFILE
@@ -0,0 +1,169 @@
+// serial_cmd.h
+// Line-based configuration over Serial (ENABLE_SERIAL_CMD).
+// This file is #included inside matrix_clock.ino after access_rtc(); the
+// sketch provides cmd_task (callback cmd_poll, interval CMD_POLL_MS).
+//
+// Each run drains at most CMD_MAX_BYTES already-received bytes into a
+// fixed line buffer and executes complete lines, so it never waits on the
+// UART and never allocates.  Lines end with CR, LF or ';'.  Replies are
+// "OK", "ERR <reason>" or the status line.  Numbers are unsigned and at
+// most 65535; anything else is "ERR bad number".
+//
+//   palette N        1–PALETTE_COUNT
+//   pattern N        0–PATTERN_COUNT-1
+//   brightness N     0–255 (until the next auto-brightness step, if enabled)
+//   colon N          0 / 1
+//   dst N            DST rule index (ENABLE_DST only)
+//   time YYYY-MM-DD HH:MM:SS   set the RTC (local standard time)
+//   status           time, palette, pattern, brightness, colon
+//   profile          timing histograms (ENABLE_PROFILE only, see profile.h)
+//
+// palette, pattern and brightness are saved like button changes
+// (ENABLE_SETTINGS).
+
+#define CMD_LINE_MAX  32 // longest accepted line, excluding the terminator
+#define CMD_MAX_BYTES 64 // bytes handled per cmd_poll() run
+
+char    cmd_line[CMD_LINE_MAX + 1];
+uint8_t cmd_len      = 0;
+bool    cmd_overflow = false; // current line is too long; discard it
+
+// True if line starts with word followed by a space or the end.
+bool cmd_is(const char *&line, const char *word) {
+  const char *p = line;
+  while (*word) {
+    if ((*p | 0x20) != *word++) { return false; } // ASCII case-fold
+    p++;
+  }
+  if (*p && *p != ' ') { return false; }
+  line = p;
+  return true;
+}
+
+#define CMD_BAD_NUMBER 0xFF // cmd_numbers(): a signed or over-long number
+
+// Parse up to max unsigned numbers separated by any non-digits.  Returns
+// how many were found, or CMD_BAD_NUMBER if one is signed (a '+' or '-'
+// not preceded by a digit, so "2026-02-01" still splits on '-') or does
+// not fit in 16 bits.
+uint8_t cmd_numbers(const char *p, uint16_t *out, uint8_t max) {
+  uint8_t n = 0;
+  char prev = ' ';
+  while (*p && n < max) {
+    if (*p < '0' || *p > '9') {
+      if ((*p == '-' || *p == '+') && (prev < '0' || prev > '9')) { return CMD_BAD_NUMBER; }
+      prev = *p++;
+      continue;
+    }
+    uint32_t v = 0;
+    while (*p >= '0' && *p <= '9') {
+      v = v * 10 + (*p++ - '0');
+      if (v > 0xFFFF) { return CMD_BAD_NUMBER; }
+    }
+    out[n++] = v;
+    prev = p[-1];
+  }
+  return n;
+}
+
+// Days in month (1–12) of year; years are 2000–2099, so every fourth is
+// a leap year.
+uint8_t cmd_month_days(uint16_t year, uint8_t month) {
+  static const uint8_t month_days[12] = {31,28,31,30,31,30,31,31,30,31,30,31};
+  return month_days[month - 1] + (month == 2 && year % 4 == 0);
+}
+
+void cmd_reply(const char *msg) { Serial.println(msg); }
+
+// Print "status" as one line.
+void cmd_status() {
+  const DateTime t = rtc.now(); // `now` is only refreshed once a minute
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%04u-%02u-%02u %02u:%02u:%02u",
+           t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second());
+  Serial.print("time ");       Serial.print(buf);
+  Serial.print(" palette ");   Serial.print(current_palette);
+  Serial.print(" (");          Serial.print(palettes[current_palette - 1].name);
+  Serial.print(")");
+  Serial.print(" pattern ");   Serial.print(current_pattern);
+  Serial.print(" brightness "); Serial.print(brightness_level);
+  Serial.print(" colon ");     Serial.println(show_colon ? 1 : 0);
+}
+
+// Execute one complete line.
+void cmd_execute(const char *line) {
+  uint16_t v[6];
+  const uint8_t n = cmd_numbers(line, v, 6);
+  if (n == CMD_BAD_NUMBER) { cmd_reply("ERR bad number"); return; }
+  if (cmd_is(line, "palette")) {
+    if (n != 1 || v[0] < 1 || v[0] > PALETTE_COUNT) { cmd_reply("ERR palette out of range"); return; }
+    current_palette = v[0];
+    change_palette();
+#if ENABLE_SETTINGS
+    settings_touch();
+#endif
+  } else if (cmd_is(line, "pattern")) {
+    if (n != 1 || v[0] >= PATTERN_COUNT) { cmd_reply("ERR pattern out of range"); return; }
+    current_pattern = v[0];
+    switch_pattern(current_pattern);
+#if ENABLE_SETTINGS
+    settings_touch();
+#endif
+  } else if (cmd_is(line, "brightness")) {
+    if (n != 1 || v[0] > 255) { cmd_reply("ERR brightness 0-255"); return; }
+    update_brightness(v[0]);
+    change_palette();
+#if ENABLE_SETTINGS
+    saved_brightness = v[0];
+    settings_touch();
+#endif
+  } else if (cmd_is(line, "colon")) {
+    if (n != 1 || v[0] > 1) { cmd_reply("ERR colon 0/1"); return; }
+    show_colon = v[0];
+    request_redraw();
+#if ENABLE_DST
+  } else if (cmd_is(line, "dst")) {
+    if (n != 1 || v[0] >= DST_RULE_COUNT) { cmd_reply("ERR dst rule out of range"); return; }
+    set_dst_rule(v[0]);
+    access_rtc();
+#endif
+  } else if (cmd_is(line, "time")) {
+    if (n != 6 || v[0] < 2000 || v[0] > 2099 || !v[1] || v[1] > 12 || !v[2] ||
+        v[2] > cmd_month_days(v[0], v[1]) || v[3] > 23 || v[4] > 59 || v[5] > 59) {
+      cmd_reply("ERR time YYYY-MM-DD HH:MM:SS");
+      return;
+    }
+    rtc.adjust(DateTime(v[0], v[1], v[2], v[3], v[4], v[5]));
+    access_rtc(); // re-reads the RTC (and restarts the SQW count)
+  } else if (cmd_is(line, "status")) {
+    cmd_status();
+    return;
+#if ENABLE_PROFILE
+  } else if (cmd_is(line, "profile")) {
+    prof_report();
+    return;
+#endif
+  } else {
+    cmd_reply("ERR unknown command");
+    return;
+  }
+  cmd_reply("OK");
+}
+
+// cmd_task callback: consume what the UART has already received.
+void cmd_poll() {
+  for (uint8_t budget = CMD_MAX_BYTES; budget && Serial.available() > 0; budget--) {
+    const char c = Serial.read();
+    if (c == '\r' || c == '\n' || c == ';') {
+      cmd_line[cmd_len] = '\0';
+      if (cmd_overflow)  { cmd_reply("ERR line too long"); }
+      else if (cmd_len)  { cmd_execute(cmd_line); }
+      cmd_len = 0;
+      cmd_overflow = false;
+    } else if (cmd_len < CMD_LINE_MAX) {
+      cmd_line[cmd_len++] = c;
+    } else {
+      cmd_overflow = true;
+    }
+  }
+}
@@ -0,0 +1,178 @@
+// settings.h
+// Palette, pattern and brightness kept across resets (ENABLE_SETTINGS).
+// This file is #included inside matrix_clock.ino after face_task_list.h;
+// the sketch includes the flash library and provides settings_task
+// (callback settings_flush).
+//
+// The store is an append log in a flash region reserved by settings_area[]
+// below, written straight through the flash API rather than through an
+// emulated EEPROM (which erases its whole sector or row on every commit).
+// Each save programs one 16-byte record into the next blank slot; a block
+// (RP2040 4 KB sector, SAMD51 8 KB row) is erased only when the log wraps
+// into it, so with SETTINGS_BLOCKS blocks of SETTINGS_BLOCK / 16 slots each
+// erase is shared by hundreds of saves and spread over every block.  Each
+// record carries a sequence number and the load picks the newest valid one.
+// A torn or blank slot fails its magic byte or checksum and is skipped;
+// with no valid record the compile-time defaults stay.
+//
+// Wear is kept down further by writing rarely.  settings_touch() does not
+// write: it (re)arms settings_task, so a burst of button presses ends in one
+// save SETTINGS_SAVE_MS after the last of them, and nothing is written if the
+// values end up unchanged.
+//
+// settings_area[] is part of the sketch image, so uploading a new sketch
+// resets the saved values.
+
+#define SETTINGS_MAGIC  0x5C
+#define SETTINGS_SLOT   16 // bytes per record; each slot is programmed once per erase
+#define SETTINGS_BLOCKS 2  // erase blocks in the log (at least 2, so an erase
+                           // never takes the newest record with it)
+
+#if defined(ARDUINO_ARCH_SAMD)
+#define SETTINGS_BLOCK 8192 // SAMD51 erase row: 16 × 512-byte pages
+#else
+#define SETTINGS_BLOCK FLASH_SECTOR_SIZE
+#endif
+
+#define SETTINGS_SLOTS        (SETTINGS_BLOCKS * SETTINGS_BLOCK / SETTINGS_SLOT)
+#define SETTINGS_BLOCK_SLOTS  (SETTINGS_BLOCK / SETTINGS_SLOT)
+
+static_assert(SETTINGS_BLOCKS >= 2, "the log needs a second block to keep the newest record while one is erased");
+
+struct SettingsRecord {
+  uint8_t  magic;      // SETTINGS_MAGIC
+  uint8_t  palette, pattern, brightness;
+  uint32_t seq;        // save number; the highest valid one is current
+  uint8_t  pad[7];     // 0xFF, left unprogrammed
+  uint8_t  check;      // checksum of the bytes above
+};
+static_assert(sizeof(SettingsRecord) == SETTINGS_SLOT, "a record fills one slot");
+
+// The log region.  Zero-filled in the image, so the first save finds slot 0
+// not blank and erases block 0 before writing.
+#if defined(ARDUINO_ARCH_SAMD)
+__attribute__((aligned(SETTINGS_BLOCK)))
+const uint8_t settings_area[SETTINGS_BLOCKS * SETTINGS_BLOCK] = {};
+FlashClass settings_flash(settings_area, sizeof(settings_area));
+#else
+__in_flash("settings") __attribute__((aligned(SETTINGS_BLOCK)))
+const uint8_t settings_area[SETTINGS_BLOCKS * SETTINGS_BLOCK] = {};
+#endif
+
+uint8_t  saved_brightness = BRIGHTNESS;      // last brightness set by hand
+SettingsRecord settings_saved = {};          // newest record in flash
+uint16_t settings_next = 0;                  // slot after settings_saved
+
+// Rotate-and-add checksum; never matches an erased (0xFF) record.
+uint8_t settings_check(const SettingsRecord &r) {
+  const uint8_t *p = (const uint8_t *)&r;
+  uint8_t sum = 0xA5;
+  for (uint8_t i = 0; i < sizeof(r) - 1; i++) { sum = ((sum << 1) | (sum >> 7)) + p[i]; }
+  return sum;
+}
+
+// Copy slot s out of flash.  The region is read through a volatile pointer:
+// the compiler must not assume the zeros it was initialised with.
+void settings_read(uint16_t s, SettingsRecord &r) {
+  const volatile uint8_t *src = settings_area + (uint32_t)s * SETTINGS_SLOT;
+  uint8_t *p = (uint8_t *)&r;
+  for (uint8_t i = 0; i < sizeof(r); i++) { p[i] = src[i]; }
+}
+
+bool settings_blank(const SettingsRecord &r) {
+  const uint8_t *p = (const uint8_t *)&r;
+  for (uint8_t i = 0; i < sizeof(r); i++) {
+    if (p[i] != 0xFF) { return false; }
+  }
+  return true;
+}
+
+bool settings_valid(const SettingsRecord &r) {
+  return r.magic == SETTINGS_MAGIC && r.check == settings_check(r);
+}
+
+// Erase block b of the log.
+void settings_erase(uint16_t b) {
+  const uint32_t off = (uint32_t)b * SETTINGS_BLOCK;
+#if defined(ARDUINO_ARCH_SAMD)
+  settings_flash.erase(settings_area + off, SETTINGS_BLOCK);
+#else
+  // Nothing may run from flash while it is erased: no interrupts (this
+  // sketch does not start the second core).
+  noInterrupts();
+  flash_range_erase((uintptr_t)settings_area - XIP_BASE + off, SETTINGS_BLOCK);
+  interrupts();
+#endif
+}
+
+// Program record r into blank slot s.
+void settings_program(uint16_t s, const SettingsRecord &r) {
+  const uint32_t off = (uint32_t)s * SETTINGS_SLOT;
+#if defined(ARDUINO_ARCH_SAMD)
+  settings_flash.write(settings_area + off, &r, sizeof(r));
+#else
+  // flash_range_program() takes whole 256-byte pages; the rest of the page
+  // is 0xFF, which leaves the slots already written there unchanged.
+  uint8_t page[FLASH_PAGE_SIZE];
+  const uint32_t page_off = off & ~(uint32_t)(FLASH_PAGE_SIZE - 1);
+  memset(page, 0xFF, sizeof(page));
+  memcpy(page + (off - page_off), &r, sizeof(r));
+  noInterrupts();
+  flash_range_program((uintptr_t)settings_area - XIP_BASE + page_off, page, FLASH_PAGE_SIZE);
+  interrupts();
+#endif
+}
+
+// Load the newest valid record and apply it to current_palette,
+// current_pattern and saved_brightness.  Call in setup() before the first
+// change_palette()/switch_pattern().
+void settings_load() {
+  bool found = false;
+  for (uint16_t s = 0; s < SETTINGS_SLOTS; s++) {
+    SettingsRecord r;
+    settings_read(s, r);
+    if (!settings_valid(r) || (found && r.seq <= settings_saved.seq)) { continue; }
+    settings_saved = r;
+    settings_next  = (s + 1) % SETTINGS_SLOTS;
+    found = true;
+  }
+  if (!found) { return; }
+  const SettingsRecord &r = settings_saved;
+  if (r.palette >= 1 && r.palette <= PALETTE_COUNT) { current_palette = r.palette; }
+  if (r.pattern < PATTERN_COUNT) { current_pattern = r.pattern; }
+  saved_brightness = r.brightness;
+}
+
+// Note that a setting changed; the save happens SETTINGS_SAVE_MS later.
+void settings_touch() { settings_task.restartDelayed(SETTINGS_SAVE_MS); }
+
+// settings_task callback: append the current values if they changed.
+void settings_flush() {
+  SettingsRecord r;
+  memset(&r, 0xFF, sizeof(r));
+  r.magic      = SETTINGS_MAGIC;
+  r.palette    = current_palette;
+  r.pattern    = current_pattern;
+  r.brightness = saved_brightness;
+  if (r.palette == settings_saved.palette && r.pattern == settings_saved.pattern &&
+      r.brightness == settings_saved.brightness && settings_saved.magic == SETTINGS_MAGIC) {
+    return;
+  }
+  r.seq   = settings_saved.magic == SETTINGS_MAGIC ? settings_saved.seq + 1 : 1;
+  r.check = settings_check(r);
+
+  // Next blank slot after the newest record.  A slot left dirty by a torn
+  // write is skipped; reaching a block that is not blank means the log has
+  // wrapped into it, so it holds only older records and is erased.
+  uint16_t s = settings_next;
+  for (;;) {
+    SettingsRecord old;
+    settings_read(s, old);
+    if (settings_blank(old)) { break; }
+    if (s % SETTINGS_BLOCK_SLOTS == 0) { settings_erase(s / SETTINGS_BLOCK_SLOTS); break; }
+    s = (s + 1) % SETTINGS_SLOTS;
+  }
+  settings_program(s, r);
+  settings_saved = r;
+  settings_next  = (s + 1) % SETTINGS_SLOTS;
+}
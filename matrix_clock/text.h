@@ -0,0 +1,108 @@
+// text.h
+// 3×5 text over the small glyph tables in font_array.h.
+// This file is #included inside matrix_clock.ino after glyph.h.
+//
+// Characters are first mapped to glyph codes (0–25 letters, 26–35 digits,
+// TEXT_SPACE) by the constexpr text_code(), so strings known at compile time
+// become code arrays in flash and drawing them does no character parsing:
+//
+//   constexpr uint8_t hello[] = TEXT("HELLO 42");
+//   draw_codes(1, 11, hello, PEN_RED);
+//
+// Glyphs advance 4 px (3 px glyph + 1 px gap) and a space 1 px, which is the
+// spacing the date row has always used.  Text is clipped to the panel.
+//
+// Styles:
+//   TEXT_NORMAL — draw the lit pixels in pen
+//   TEXT_PUNCH  — draw everything *but* the lit pixels in pen, including the
+//                 gap column left of each glyph, so the letters show the
+//                 background through a solid bar (use PEN_BLACK to erase)
+
+enum { TEXT_NORMAL, TEXT_PUNCH };
+
+#define TEXT_DIGIT0  26   // code of '0'
+#define TEXT_SPACE   36   // blank glyph; also used for unmapped characters
+#define TEXT_END     0xFF // terminator
+#define TEXT_MAX     16   // longest string TEXT() converts
+
+// Glyph code of an ASCII character.
+constexpr uint8_t text_code(char c) {
+  return (c >= 'A' && c <= 'Z') ? c - 'A' :
+         (c >= 'a' && c <= 'z') ? c - 'a' :
+         (c >= '0' && c <= '9') ? TEXT_DIGIT0 + (c - '0') : TEXT_SPACE;
+}
+
+// Deliberately not constexpr: reaching it in a constexpr initialiser is a
+// compile error, which is how an over-long TEXT() string is reported.
+uint8_t text_string_too_long();
+
+// i-th code of a string of length len, TEXT_END past the end.  Strings
+// must leave room for the terminator (at most TEXT_MAX - 1 characters).
+constexpr uint8_t text_code_at(const char *s, size_t len, uint8_t i) {
+  return len > TEXT_MAX - 1 ? text_string_too_long() :
+         i < len ? text_code(s[i]) : TEXT_END;
+}
+
+// Initialiser for a TEXT_MAX-entry code array from a string literal; declare
+// the array constexpr so the conversion is guaranteed to happen at compile
+// time.
+#define TEXT_AT(s, i) text_code_at(s, sizeof(s) - 1, i)
+#define TEXT(s) { \
+  TEXT_AT(s, 0),  TEXT_AT(s, 1),  TEXT_AT(s, 2),  TEXT_AT(s, 3),  \
+  TEXT_AT(s, 4),  TEXT_AT(s, 5),  TEXT_AT(s, 6),  TEXT_AT(s, 7),  \
+  TEXT_AT(s, 8),  TEXT_AT(s, 9),  TEXT_AT(s, 10), TEXT_AT(s, 11), \
+  TEXT_AT(s, 12), TEXT_AT(s, 13), TEXT_AT(s, 14), TEXT_AT(s, 15) }
+
+const uint8_t blank_rows[5] = {0, 0, 0, 0, 0};
+
+// Row bitmasks of a glyph code.
+inline const uint8_t *text_rows(uint8_t code) {
+  return code < TEXT_DIGIT0 ? letter_rows[code] :
+         code < TEXT_SPACE  ? small_num_rows[code - TEXT_DIGIT0] : blank_rows;
+}
+
+// Horizontal advance of a glyph code, in face units (LS() gives pixels).
+inline uint8_t text_advance(uint8_t code) {
+  return code == TEXT_SPACE ? 1 : 4;
+}
+
+// Draw one glyph code at pixel (x, y), scaled like drawGlyph(); returns
+// the x of the next glyph.
+int16_t draw_code(int16_t x, int16_t y, uint8_t code, uint16_t pen, uint8_t style = TEXT_NORMAL) {
+  const int16_t adv = LS(text_advance(code));
+  if (x - LS(1) >= (int16_t)matrix.width() || x + adv <= 0) { return x + adv; }
+  if (style == TEXT_PUNCH) {
+    fb_fill_rect(x - LS(1), y, code == TEXT_SPACE ? adv : LS(1), LS(5), pen);
+    if (code != TEXT_SPACE) { drawGlyph<3, 5>(x, y, text_rows(code), pen, true); }
+  } else if (code != TEXT_SPACE) {
+    drawGlyph<3, 5>(x, y, text_rows(code), pen);
+  }
+  return x + adv;
+}
+
+// Draw a TEXT_END-terminated code array; returns the x after the last glyph.
+int16_t draw_codes(int16_t x, int16_t y, const uint8_t *codes, uint16_t pen,
+                   uint8_t style = TEXT_NORMAL) {
+  for (; *codes != TEXT_END && x - LS(1) < (int16_t)matrix.width(); codes++) {
+    x = draw_code(x, y, *codes, pen, style);
+  }
+  return x;
+}
+
+// Draw a runtime string (mapped one character at a time).
+int16_t draw_text(int16_t x, int16_t y, const char *s, uint16_t pen,
+                  uint8_t style = TEXT_NORMAL) {
+  for (; *s && x - LS(1) < (int16_t)matrix.width(); s++) {
+    x = draw_code(x, y, text_code(*s), pen, style);
+  }
+  return x;
+}
+
+// Month abbreviations as glyph codes, for the date row.
+#define MONTH_CODES(s) { text_code(s[0]), text_code(s[1]), text_code(s[2]) }
+const uint8_t months[12][3] = {
+  MONTH_CODES("JAN"), MONTH_CODES("FEB"), MONTH_CODES("MAR"), MONTH_CODES("APR"),
+  MONTH_CODES("MAY"), MONTH_CODES("JUN"), MONTH_CODES("JUL"), MONTH_CODES("AUG"),
+  MONTH_CODES("SEP"), MONTH_CODES("OCT"), MONTH_CODES("NOV"), MONTH_CODES("DEC")
+};
+#undef MONTH_CODES
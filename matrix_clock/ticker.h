@@ -0,0 +1,79 @@
+// ticker.h
+// Scrolling message in the date row (ENABLE_TICKER).
+// This file is #included inside matrix_clock.ino after text.h; the sketch
+// provides ticker_task (callback ticker_tick, interval TICKER_MS) and
+// render_ticker(), which redraws just the strip.
+//
+// The visible strip is a ring of TICKER_COLS 5-bit column masks (bit r =
+// face row 11 + r), one per face unit across the whole panel width.  Each
+// tick renders just the next column of the message into the slot of the
+// oldest one and advances the head, so a tick costs one column whatever
+// the message length, and memory is the ring plus a read position.  On a
+// static face the tick then redraws only the date rows, not the frame.  The
+// message is read straight from the caller's string and repeats after
+// TICKER_GAP blank columns.
+
+#define TICKER_UNITS ((MATRIX_WIDTH + LAYOUT_SCALE - 1) / LAYOUT_SCALE) // panel width in face units
+#define TICKER_COLS  (TICKER_UNITS <= 32 ? 32 : TICKER_UNITS <= 64 ? 64 : \
+                      TICKER_UNITS <= 128 ? 128 : 256) // power of two ≥ TICKER_UNITS
+#define TICKER_GAP   TICKER_UNITS                   // blank columns between repeats
+
+static_assert(TICKER_COLS >= TICKER_UNITS && !(TICKER_COLS & (TICKER_COLS - 1)),
+              "TICKER_COLS must be a power of two covering the panel width");
+
+uint8_t ticker_ring[TICKER_COLS]; // column masks; ticker_head is the oldest
+uint8_t ticker_head = 0;
+const char *ticker_msg = nullptr; // message being streamed (nullptr = date row)
+uint16_t ticker_pos = 0;          // index of the character being rendered
+uint16_t ticker_col = 0;          // column within it (or within the gap)
+
+// Render the next column of the message: a glyph's 3 columns, then its
+// 1 px gap; a space is one blank column.
+uint8_t ticker_next_column() {
+  if (!ticker_msg[ticker_pos]) {
+    if (++ticker_col >= TICKER_GAP) { ticker_pos = 0; ticker_col = 0; }
+    return 0;
+  }
+  const uint8_t code = text_code(ticker_msg[ticker_pos]);
+  uint8_t bits = 0;
+  if (code != TEXT_SPACE && ticker_col < 3) {
+    const uint8_t *rows = text_rows(code);
+    for (uint8_t r = 0; r < 5; r++) { bits |= ((rows[r] >> (2 - ticker_col)) & 1) << r; }
+  }
+  if (++ticker_col == text_advance(code)) { ticker_col = 0; ticker_pos++; }
+  return bits;
+}
+
+// ticker_task callback: shift one column in on the right.
+void ticker_tick() {
+  ticker_ring[ticker_head] = ticker_next_column();
+  ticker_head = (ticker_head + 1) & (TICKER_COLS - 1);
+  render_ticker();
+}
+
+// Start scrolling msg (any length; it must outlive the ticker) from an
+// empty strip.  nullptr or "" goes back to the date.
+void ticker_start(const char *msg) {
+  memset(ticker_ring, 0, sizeof(ticker_ring));
+  ticker_head = 0;
+  ticker_pos  = 0;
+  ticker_col  = 0;
+  ticker_msg  = (msg && *msg) ? msg : nullptr;
+  if (ticker_msg) { ticker_task.enable(); }
+  else            { ticker_task.disable(); }
+  request_redraw();
+}
+
+// Draw the visible columns in pen, 8 columns per glyph blit.
+void ticker_draw(uint16_t pen) {
+  const int16_t w = (matrix.width() + LAYOUT_SCALE - 1) / LAYOUT_SCALE; // face units
+  uint8_t pos = ticker_head + TICKER_COLS - w; // oldest visible column
+  for (int16_t u = 0; u < w; u += 8) {
+    uint8_t rows[5] = {0, 0, 0, 0, 0};
+    for (uint8_t c = 0; c < 8; c++, pos++) {
+      const uint8_t col = ticker_ring[pos & (TICKER_COLS - 1)];
+      for (uint8_t r = 0; r < 5; r++) { rows[r] |= ((col >> r) & 1) << (7 - c); }
+    }
+    drawGlyph<8, 5>(LS(u), date_region.y, rows, pen);
+  }
+}
@@ -0,0 +1,81 @@
+// Adafruit_GFX.h — host stand-in for the Adafruit GFX library.
+// Mirrors the GFX rotation and clipping rules so direct canvas writes and
+// drawPixel() land in the same place as on the device.  Every drawPixel()
+// call is counted in sim_stats.draw_pixel_calls.
+
+#pragma once
+
+#include <Arduino.h>
+#include "../sim.h"
+
+class Adafruit_GFX {
+public:
+  Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h), rotation(0) {}
+  virtual ~Adafruit_GFX() {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+  void setRotation(uint8_t r) {
+    rotation = r & 3;
+    _width   = (rotation & 1) ? HEIGHT : WIDTH;
+    _height  = (rotation & 1) ? WIDTH  : HEIGHT;
+  }
+  uint8_t getRotation() const { return rotation; }
+  int16_t width()  const { return _width; }
+  int16_t height() const { return _height; }
+
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) { drawPixel(x, y + i, color); }
+  }
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) { drawPixel(x + i, y, color); }
+  }
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) { drawFastVLine(i, y, h, color); }
+  }
+  virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+  // Bresenham, as in Adafruit_GFX::writeLine().
+  virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)   { std::swap(x0, y0); std::swap(x1, y1); }
+    if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+    int16_t dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+      if (steep) { drawPixel(y0, x0, color); } else { drawPixel(x0, y0, color); }
+      err -= dy;
+      if (err < 0) { y0 += ystep; err += dx; }
+    }
+  }
+
+protected:
+  const int16_t WIDTH, HEIGHT; // physical size, before rotation
+  int16_t _width, _height;     // logical size, after rotation
+  uint8_t rotation;
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+public:
+  GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    buffer = (uint16_t *)calloc((size_t)w * h, sizeof(uint16_t));
+  }
+  ~GFXcanvas16() { free(buffer); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    sim_stats.draw_pixel_calls++;
+    if (x < 0 || y < 0 || x >= _width || y >= _height) { return; }
+    int16_t t;
+    switch (rotation) {
+      case 1: t = x; x = WIDTH - 1 - y; y = t;          break;
+      case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y;    break;
+      case 3: t = x; x = y; y = HEIGHT - 1 - t;         break;
+    }
+    buffer[x + y * WIDTH] = color;
+  }
+
+  uint16_t *getBuffer() const { return buffer; }
+
+protected:
+  uint16_t *buffer;
+};
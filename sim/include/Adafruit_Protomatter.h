@@ -0,0 +1,33 @@
+// Adafruit_Protomatter.h — host stand-in for the Protomatter HUB75 driver.
+// The canvas behaves exactly like the real GFXcanvas16; show() hands the
+// frame to the simulator, which counts it and optionally writes it out.
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+typedef enum {
+  PROTOMATTER_OK,
+  PROTOMATTER_ERR_PINS,
+  PROTOMATTER_ERR_MALLOC,
+  PROTOMATTER_ERR_ARG,
+} ProtomatterStatus;
+
+class Adafruit_Protomatter : public GFXcanvas16 {
+public:
+  // Height is inferred from the address-pin count as on the device:
+  // 2^addrCount × 2 rows per chain.
+  Adafruit_Protomatter(uint16_t bitWidth, uint8_t bitDepth,
+                       uint8_t rgbCount, uint8_t *rgbList,
+                       uint8_t addrCount, uint8_t *addrList,
+                       uint8_t clockPin, uint8_t latchPin, uint8_t oePin,
+                       bool doubleBuffer, int8_t tile = 1, void *timer = nullptr)
+    : GFXcanvas16(bitWidth, (2 << addrCount) * (tile < 0 ? -tile : tile)) {}
+
+  ProtomatterStatus begin() { return PROTOMATTER_OK; }
+  void show() { sim_present(buffer, WIDTH, HEIGHT, rotation); }
+
+  static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+};
@@ -0,0 +1,93 @@
+// Arduino.h — host stand-in for the Arduino core, used by the simulator.
+// Only the subset the clock sketches use is provided.  Time is virtual:
+// millis()/micros() read the simulator clock, which advances only through
+// delay(), scheduler idle time and the per-loop cost set on the command line.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define DEC 10
+#define HEX 16
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define F(s) (s)
+
+using std::min;
+using std::max;
+
+template <typename T> T constrain(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+inline long map(long v, long in_lo, long in_hi, long out_lo, long out_hi) {
+  return (v - in_lo) * (out_hi - out_lo) / (in_hi - in_lo) + out_lo;
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void randomSeed(unsigned long seed);
+long random(long max);
+long random(long min, long max);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int  digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  analogRead(uint8_t pin);
+
+inline int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(int irq, void (*isr)(), int mode);
+void detachInterrupt(int irq);
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// Serial: output goes to stdout, input comes from the simulator's scripted
+// input queue (see sim.h).
+class SimSerial {
+public:
+  void begin(unsigned long) {}
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t c);
+  size_t write(const char *s) { return print(s); }
+  size_t print(const char *s);
+  size_t print(char c)                      { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC)       { return print((long)v, base); }
+  size_t print(unsigned v, int base = DEC)  { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(double v, int digits = 2);
+  size_t println()                          { return print("\r\n"); }
+  template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+  void flush() { fflush(stdout); }
+  operator bool() const { return true; }
+};
+extern SimSerial Serial;
@@ -0,0 +1,72 @@
+// RTClib.h — host stand-in for Adafruit RTClib (DateTime, TimeSpan and
+// RTC_DS3231).  The DS3231 reads the simulator's virtual clock; every now()
+// call is counted in sim_stats.rtc_reads as one I²C transaction.
+
+#pragma once
+
+#include <Arduino.h>
+
+class TimeSpan {
+public:
+  TimeSpan(int32_t seconds = 0) : _seconds(seconds) {}
+  TimeSpan(int16_t days, int8_t hours, int8_t minutes, int8_t seconds)
+    : _seconds((int32_t)days * 86400L + (int32_t)hours * 3600 + (int32_t)minutes * 60 + seconds) {}
+  int32_t totalseconds() const { return _seconds; }
+  int16_t days()    const { return _seconds / 86400L; }
+  int8_t  hours()   const { return _seconds / 3600 % 24; }
+  int8_t  minutes() const { return _seconds / 60 % 60; }
+  int8_t  seconds() const { return _seconds % 60; }
+private:
+  int32_t _seconds;
+};
+
+// Valid for 2000-2099, like the real class.
+class DateTime {
+public:
+  DateTime(uint32_t t = 946684800UL);
+  DateTime(uint16_t year, uint8_t month, uint8_t day,
+           uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+  DateTime(const char *date, const char *time); // __DATE__, __TIME__
+
+  uint16_t year()   const { return 2000U + yOff; }
+  uint8_t  month()  const { return m; }
+  uint8_t  day()    const { return d; }
+  uint8_t  hour()   const { return hh; }
+  uint8_t  twelveHour() const { return (hh == 0 || hh == 12) ? 12 : hh % 12; }
+  uint8_t  isPM()   const { return hh >= 12; }
+  uint8_t  minute() const { return mm; }
+  uint8_t  second() const { return ss; }
+  uint8_t  dayOfTheWeek() const; // 0 = Sunday
+  uint32_t unixtime() const;
+
+  DateTime operator+(const TimeSpan &span) const { return DateTime(unixtime() + span.totalseconds()); }
+  DateTime operator-(const TimeSpan &span) const { return DateTime(unixtime() - span.totalseconds()); }
+  TimeSpan operator-(const DateTime &right) const { return TimeSpan((int32_t)(unixtime() - right.unixtime())); }
+  bool operator<(const DateTime &right)  const { return unixtime() < right.unixtime(); }
+  bool operator>(const DateTime &right)  const { return right < *this; }
+  bool operator<=(const DateTime &right) const { return !(right < *this); }
+  bool operator>=(const DateTime &right) const { return !(*this < right); }
+  bool operator==(const DateTime &right) const { return unixtime() == right.unixtime(); }
+  bool operator!=(const DateTime &right) const { return !(*this == right); }
+
+protected:
+  uint8_t yOff, m, d, hh, mm, ss;
+};
+
+enum Ds3231SqwPinMode {
+  DS3231_OFF            = 0x1C,
+  DS3231_SquareWave1Hz  = 0x00,
+  DS3231_SquareWave1kHz = 0x08,
+  DS3231_SquareWave4kHz = 0x10,
+  DS3231_SquareWave8kHz = 0x18,
+};
+
+class RTC_DS3231 {
+public:
+  bool begin() { return true; }
+  DateTime now();
+  void adjust(const DateTime &dt);
+  bool lostPower() { return false; }
+  void writeSqwPinMode(Ds3231SqwPinMode mode);
+  Ds3231SqwPinMode readSqwPinMode();
+};
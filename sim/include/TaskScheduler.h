@@ -0,0 +1,87 @@
+// TaskScheduler.h — host stand-in for arkhipenko/TaskScheduler.
+// Same scheduling rules as the library's execute(): a task runs when its
+// delay has elapsed since its previous run, and the previous-run time then
+// advances by exactly one interval (no drift).  When a pass finds nothing to
+// do and sleeping is allowed, the sleep method is called and the simulator's
+// clock jumps straight to the next due task, which is what WFI does on the
+// device, only faster than real time.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define TASK_IMMEDIATE   0
+#define TASK_FOREVER     (-1)
+#define TASK_ONCE        1
+#define TASK_MILLISECOND 1UL
+#define TASK_SECOND      1000UL
+#define TASK_MINUTE      60000UL
+#define TASK_HOUR        3600000UL
+
+typedef void (*TaskCallback)();
+typedef void (*SleepCallback)(unsigned long aDuration);
+
+class Scheduler;
+
+class Task {
+public:
+  Task(unsigned long aInterval = 0, long aIterations = 0, TaskCallback aCallback = nullptr,
+       Scheduler *aScheduler = nullptr, bool aEnable = false);
+
+  void enable();
+  bool enableIfNot() { bool was = iEnabled; if (!was) { enable(); } return was; }
+  void enableDelayed(unsigned long aDelay = 0) { enable(); delay(aDelay); }
+  bool disable() { bool was = iEnabled; iEnabled = false; return was; }
+  bool isEnabled() const { return iEnabled; }
+  void restart() { iIterations = iSetIterations; enable(); }
+  void restartDelayed(unsigned long aDelay = 0) { restart(); delay(aDelay); }
+  void delay(unsigned long aDelay = 0) { iDelay = aDelay ? aDelay : iInterval; iPrevious = millis(); }
+  void forceNextIteration() { iPrevious = millis() - (iDelay = iInterval); }
+
+  void setCallback(TaskCallback aCallback) { iCallback = aCallback; }
+  void setInterval(unsigned long aInterval) { iInterval = aInterval; delay(); }
+  unsigned long getInterval() const { return iInterval; }
+  void setIterations(long aIterations) { iSetIterations = iIterations = aIterations; }
+  long getIterations() const { return iIterations; }
+  unsigned long getRunCounter() const { return iRunCounter; }
+  bool isFirstIteration() const { return iRunCounter <= 1; }
+  bool isLastIteration() const { return iIterations == 0; }
+  // _TASK_TIMECRITICAL API.  Always recorded here, so the sketch and
+  // sim_core.cpp agree on the class layout whether or not the sketch
+  // defines the macro.
+  long getStartDelay() const { return iStartDelay; } // ms the last run started late
+  long getOverrun() const { return iOverrun; }       // ms to the next run; < 0 = behind
+
+private:
+  friend class Scheduler;
+  unsigned long iInterval;
+  unsigned long iDelay    = 0;
+  unsigned long iPrevious = 0;
+  unsigned long iRunCounter = 0;
+  long iStartDelay = 0;
+  long iOverrun    = 0;
+  long iIterations;
+  long iSetIterations;
+  TaskCallback iCallback;
+  bool iEnabled = false;
+  Task *iNext = nullptr;
+  Scheduler *iScheduler = nullptr;
+};
+
+class Scheduler {
+public:
+  void init() { iFirst = nullptr; }
+  void addTask(Task &aTask);
+  void deleteTask(Task &aTask);
+  void enableAll();
+  void disableAll();
+  void setSleepMethod(SleepCallback aCallback) { iSleepMethod = aCallback; }
+  void allowSleep(bool aState = true) { iAllowSleep = aState; }
+  long timeUntilNextIteration(Task &aTask);
+  bool execute();
+
+private:
+  Task *iFirst = nullptr;
+  SleepCallback iSleepMethod = nullptr;
+  bool iAllowSleep = true;
+};
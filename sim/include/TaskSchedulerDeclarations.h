@@ -0,0 +1,3 @@
+// TaskSchedulerDeclarations.h — host stand-in; everything lives in TaskScheduler.h.
+#pragma once
+#include <TaskScheduler.h>
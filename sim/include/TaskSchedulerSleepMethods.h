@@ -0,0 +1,3 @@
+// TaskSchedulerSleepMethods.h — host stand-in.  The simulator's scheduler
+// advances virtual time itself when idle, so no default sleep method is needed.
+#pragma once
@@ -0,0 +1,21 @@
+// hardware/flash.h — host stand-in for the pico-sdk flash API of the RP2040
+// core.  Host addresses stand in for XIP addresses (XIP_BASE is 0, so the
+// offsets are host pointers, hence uintptr_t where the SDK has uint32_t).
+// Data marked __in_flash() is collected in one section the simulator can
+// load and save with --eeprom FILE.  NOR rules hold: an erase sets whole
+// 4 KB sectors to 0xFF and is counted per sector (see sim.h), a program
+// takes whole 256-byte pages and can only clear bits.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define XIP_BASE          ((uintptr_t)0)
+#define FLASH_PAGE_SIZE   256u
+#define FLASH_SECTOR_SIZE 4096u
+
+#define __in_flash(group) __attribute__((section("sim_flash")))
+
+void flash_range_erase(uintptr_t flash_offs, size_t count);
+void flash_range_program(uintptr_t flash_offs, const uint8_t *data, size_t count);
@@ -0,0 +1,67 @@
+// sim.h
+// Control surface of the host simulator: virtual clock, scripted inputs,
+// frame sink and per-run counters.  Included by the stub library headers in
+// sim/include and by the simulator driver; sketches never include it.
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+// ---- COUNTERS ---------------------------------------------------------------
+
+struct SimStats {
+  unsigned long long draw_pixel_calls; // GFXcanvas16::drawPixel() calls
+  unsigned long      show_calls;       // Adafruit_Protomatter::show() calls
+  unsigned long      loop_passes;      // loop() calls
+  unsigned long      rtc_reads;        // RTC_DS3231::now() calls (I²C transactions)
+  unsigned long      idle_sleeps;      // scheduler passes that ended in sleep
+  unsigned long      eeprom_commits;   // flash page programs (settings saves)
+  unsigned long      eeprom_erases;    // flash sector erases
+  unsigned long      eeprom_max_wear;  // most erase cycles of any one sector
+};
+extern SimStats sim_stats;
+
+// ---- VIRTUAL CLOCK ----------------------------------------------------------
+
+unsigned long long sim_time_us();
+void sim_advance_us(unsigned long long us);
+
+// Schedule fn to run once the virtual clock reaches at_us.  Scheduler idle
+// sleeps wake early for these, like an interrupt ending a WFI.
+void sim_schedule(unsigned long long at_us, void (*fn)(void *), void *arg);
+// Run every event that is due; returns the time of the next one (or ~0ULL).
+unsigned long long sim_run_events();
+
+// ---- INPUTS -----------------------------------------------------------------
+
+// Drive a digital input; fires handlers registered with attachInterrupt().
+void sim_set_pin(uint8_t pin, int level);
+// Value returned by analogRead(pin), 0-1023.
+void sim_set_analog(uint8_t pin, int value);
+// Append bytes to the Serial receive queue.
+void sim_serial_feed(const char *text);
+// Collect Serial output in memory instead of printing it (for tests), and
+// take what has been collected so far.
+void sim_serial_capture(bool on);
+std::string sim_serial_take();
+
+// ---- RTC --------------------------------------------------------------------
+
+void sim_rtc_set(uint32_t unixtime);
+// Pin wired to the DS3231 INT/SQW output (default 4, -1 = not wired).  While
+// the 1 Hz square wave is enabled it falls on every RTC second and rises
+// 500 ms later.
+void sim_rtc_sqw_pin(int pin);
+
+// ---- FLASH ------------------------------------------------------------------
+
+// Back the sketch's __in_flash() data (the settings store) with a file:
+// loaded now, rewritten after every erase or program.  Without one, or
+// while the file does not exist yet, the section keeps the image contents.
+void sim_eeprom_file(const char *path);
+
+// ---- FRAME SINK -------------------------------------------------------------
+
+// Called by Adafruit_Protomatter::show() with the raw (unrotated) canvas.
+void sim_present(const uint16_t *buf, int16_t width, int16_t height, uint8_t rotation);
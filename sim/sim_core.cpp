@@ -0,0 +1,409 @@
+// sim_core.cpp
+// Implementations behind the stub Arduino, RTClib and TaskScheduler headers.
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include <TaskScheduler.h>
+#include <hardware/flash.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <map>
+#include <vector>
+#include <deque>
+#include <string>
+#include "sim.h"
+
+SimStats  sim_stats;
+SimSerial Serial;
+
+// ---- VIRTUAL CLOCK ----------------------------------------------------------
+
+static unsigned long long now_us = 0;
+
+unsigned long long sim_time_us()          { return now_us; }
+void sim_advance_us(unsigned long long us) { now_us += us; }
+
+unsigned long millis()            { return (unsigned long)(now_us / 1000ULL); }
+unsigned long micros()            { return (unsigned long)now_us; }
+void delay(unsigned long ms)      { now_us += ms * 1000ULL; sim_run_events(); }
+void delayMicroseconds(unsigned int us) { now_us += us; }
+void yield()                      {}
+
+struct SimEvent {
+  unsigned long long at_us;
+  void (*fn)(void *);
+  void *arg;
+};
+static std::vector<SimEvent> events; // kept sorted by at_us
+
+void sim_schedule(unsigned long long at_us, void (*fn)(void *), void *arg) {
+  SimEvent ev = {at_us, fn, arg};
+  std::vector<SimEvent>::iterator it = events.begin();
+  while (it != events.end() && it->at_us <= at_us) { ++it; }
+  events.insert(it, ev);
+}
+
+unsigned long long sim_run_events() {
+  while (!events.empty() && events.front().at_us <= now_us) {
+    SimEvent ev = events.front();
+    events.erase(events.begin());
+    ev.fn(ev.arg);
+  }
+  return events.empty() ? ~0ULL : events.front().at_us;
+}
+
+// ---- RANDOM -----------------------------------------------------------------
+
+static uint32_t rng_state = 1;
+
+void randomSeed(unsigned long seed) { rng_state = seed ? seed : 1; }
+
+long random(long max) {
+  if (max <= 0) { return 0; }
+  rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5;
+  return (long)(rng_state % (uint32_t)max);
+}
+
+long random(long min, long max) { return min >= max ? min : min + random(max - min); }
+
+// ---- PINS AND INTERRUPTS ----------------------------------------------------
+
+static const int SIM_PINS = 64;
+static int   pin_level[SIM_PINS];
+static int   analog_value[SIM_PINS];
+static void (*pin_isr[SIM_PINS])();
+static int   pin_isr_mode[SIM_PINS];
+
+static bool pin_ok(int pin) { return pin >= 0 && pin < SIM_PINS; }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin_ok(pin) && mode == INPUT_PULLUP) { pin_level[pin] = HIGH; }
+}
+
+int  digitalRead(uint8_t pin)               { return pin_ok(pin) ? pin_level[pin] : LOW; }
+void digitalWrite(uint8_t pin, uint8_t val) { if (pin_ok(pin)) { pin_level[pin] = val ? HIGH : LOW; } }
+int  analogRead(uint8_t pin)                { return pin_ok(pin) ? analog_value[pin] : 0; }
+
+void attachInterrupt(int irq, void (*isr)(), int mode) {
+  if (pin_ok(irq)) { pin_isr[irq] = isr; pin_isr_mode[irq] = mode; }
+}
+
+void detachInterrupt(int irq) {
+  if (pin_ok(irq)) { pin_isr[irq] = nullptr; }
+}
+
+void sim_set_pin(uint8_t pin, int level) {
+  if (!pin_ok(pin)) { return; }
+  int old = pin_level[pin];
+  pin_level[pin] = level ? HIGH : LOW;
+  if (old == pin_level[pin] || !pin_isr[pin]) { return; }
+  int mode = pin_isr_mode[pin];
+  bool fire = mode == CHANGE ||
+              (mode == FALLING && pin_level[pin] == LOW) ||
+              (mode == RISING  && pin_level[pin] == HIGH);
+  if (fire) { pin_isr[pin](); }
+}
+
+void sim_set_analog(uint8_t pin, int value) {
+  if (pin_ok(pin)) { analog_value[pin] = constrain(value, 0, 1023); }
+}
+
+// ---- SERIAL -----------------------------------------------------------------
+
+static std::deque<uint8_t> serial_rx;
+
+void sim_serial_feed(const char *text) {
+  while (*text) { serial_rx.push_back((uint8_t)*text++); }
+}
+
+int SimSerial::available() { return (int)serial_rx.size(); }
+int SimSerial::peek()      { return serial_rx.empty() ? -1 : serial_rx.front(); }
+
+int SimSerial::read() {
+  if (serial_rx.empty()) { return -1; }
+  int c = serial_rx.front();
+  serial_rx.pop_front();
+  return c;
+}
+
+static bool        serial_capturing = false;
+static std::string serial_tx;  // captured output while serial_capturing
+
+void sim_serial_capture(bool on) { serial_capturing = on; }
+
+std::string sim_serial_take() {
+  std::string out;
+  out.swap(serial_tx);
+  return out;
+}
+
+// Send n bytes to stdout or, while capturing, to serial_tx.
+static size_t serial_out(const char *s, size_t n) {
+  if (serial_capturing) { serial_tx.append(s, n); return n; }
+  return fwrite(s, 1, n, stdout);
+}
+
+// printf into a line-sized buffer, then serial_out().
+template <typename... Args>
+static size_t serial_printf(const char *fmt, Args... args) {
+  char buf[64];
+  int n = snprintf(buf, sizeof(buf), fmt, args...);
+  return n > 0 ? serial_out(buf, std::min((size_t)n, sizeof(buf) - 1)) : 0;
+}
+
+size_t SimSerial::write(uint8_t c)        { char ch = (char)c; return serial_out(&ch, 1); }
+size_t SimSerial::print(const char *s)    { return serial_out(s, strlen(s)); }
+size_t SimSerial::print(double v, int dp) { return serial_printf("%.*f", dp, v); }
+
+size_t SimSerial::print(long v, int base) {
+  return base == HEX ? serial_printf("%lX", (unsigned long)v) : serial_printf("%ld", v);
+}
+
+size_t SimSerial::print(unsigned long v, int base) {
+  return base == HEX ? serial_printf("%lX", v) : serial_printf("%lu", v);
+}
+
+// ---- FLASH ------------------------------------------------------------------
+
+// Everything a sketch marks __in_flash() lands in the section sim_flash,
+// which the linker brackets with these symbols (null when there is none).
+extern "C" uint8_t __start_sim_flash[] __attribute__((weak));
+extern "C" uint8_t __stop_sim_flash[] __attribute__((weak));
+
+static const char *eeprom_path = nullptr;
+static bool        flash_open  = false;
+static std::map<uintptr_t, unsigned long> flash_wear; // erase cycles of each sector
+
+// The section is read-only like the rest of the image; make it writable for
+// the stand-in erase/program calls, and load the --eeprom file into it.
+static void flash_begin() {
+  if (flash_open || (uintptr_t)__stop_sim_flash <= (uintptr_t)__start_sim_flash) { return; }
+  flash_open = true;
+  const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+  const uintptr_t lo = (uintptr_t)__start_sim_flash & ~(page - 1);
+  const uintptr_t hi = ((uintptr_t)__stop_sim_flash + page - 1) & ~(page - 1);
+  if (mprotect((void *)lo, hi - lo, PROT_READ | PROT_WRITE) != 0) {
+    perror("sim: mprotect flash");
+    exit(1);
+  }
+  if (eeprom_path) {
+    if (FILE *f = fopen(eeprom_path, "rb")) {
+      size_t got = fread(__start_sim_flash, 1, __stop_sim_flash - __start_sim_flash, f);
+      (void)got;
+      fclose(f);
+    }
+  }
+}
+
+static void flash_save() {
+  if (!eeprom_path) { return; }
+  if (FILE *f = fopen(eeprom_path, "wb")) {
+    fwrite(__start_sim_flash, 1, __stop_sim_flash - __start_sim_flash, f);
+    fclose(f);
+  }
+}
+
+// Abort on calls the real SDK would reject or that would hit other data.
+static uint8_t *flash_range(uintptr_t offs, size_t count, size_t align, const char *what) {
+  uint8_t *p = (uint8_t *)(XIP_BASE + offs);
+  if (offs % align || count % align || p < __start_sim_flash || p + count > __stop_sim_flash) {
+    fprintf(stderr, "sim: %s(%#lx, %zu) outside the flash section or not aligned to %zu\n", what,
+            (unsigned long)offs, count, align);
+    exit(1);
+  }
+  flash_begin();
+  return p;
+}
+
+void sim_eeprom_file(const char *path) {
+  eeprom_path = path;
+  flash_begin();
+}
+
+void flash_range_erase(uintptr_t offs, size_t count) {
+  uint8_t *p = flash_range(offs, count, FLASH_SECTOR_SIZE, "flash_range_erase");
+  memset(p, 0xFF, count);
+  for (size_t s = 0; s < count; s += FLASH_SECTOR_SIZE) {
+    sim_stats.eeprom_erases++;
+    unsigned long &wear = flash_wear[(uintptr_t)(p + s)];
+    if (++wear > sim_stats.eeprom_max_wear) { sim_stats.eeprom_max_wear = wear; }
+  }
+  flash_save();
+}
+
+void flash_range_program(uintptr_t offs, const uint8_t *data, size_t count) {
+  uint8_t *p = flash_range(offs, count, FLASH_PAGE_SIZE, "flash_range_program");
+  for (size_t i = 0; i < count; i++) { p[i] &= data[i]; } // programming only clears bits
+  sim_stats.eeprom_commits++;
+  flash_save();
+}
+
+// ---- RTClib -----------------------------------------------------------------
+
+static const uint8_t days_in_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+// Days since 2000-01-01 (same helper as RTClib).
+static uint16_t date2days(uint16_t y, uint8_t m, uint8_t d) {
+  if (y >= 2000U) { y -= 2000U; }
+  uint16_t days = d;
+  for (uint8_t i = 1; i < m; ++i) { days += days_in_month[i - 1]; }
+  if (m > 2 && y % 4 == 0) { ++days; }
+  return days + 365 * y + (y + 3) / 4 - 1;
+}
+
+DateTime::DateTime(uint32_t t) {
+  t -= 946684800UL; // seconds from 1970 to 2000
+  ss = t % 60; t /= 60;
+  mm = t % 60; t /= 60;
+  hh = t % 24;
+  uint16_t days = t / 24;
+  uint8_t leap;
+  for (yOff = 0;; ++yOff) {
+    leap = yOff % 4 == 0;
+    if (days < 365U + leap) { break; }
+    days -= 365 + leap;
+  }
+  for (m = 1; m < 12; ++m) {
+    uint8_t dim = days_in_month[m - 1];
+    if (leap && m == 2) { ++dim; }
+    if (days < dim) { break; }
+    days -= dim;
+  }
+  d = days + 1;
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec) {
+  if (year >= 2000U) { year -= 2000U; }
+  yOff = year; m = month; d = day; hh = hour; mm = min; ss = sec;
+}
+
+DateTime::DateTime(const char *date, const char *time) {
+  static const char names[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  char mon[4] = {0};
+  unsigned y = 2000, dd = 1, h = 0, mi = 0, s = 0;
+  sscanf(date, "%3s %u %u", mon, &dd, &y);
+  sscanf(time, "%u:%u:%u", &h, &mi, &s);
+  const char *p = strstr(names, mon);
+  yOff = y - 2000; m = p ? (p - names) / 3 + 1 : 1; d = dd; hh = h; mm = mi; ss = s;
+}
+
+uint8_t DateTime::dayOfTheWeek() const {
+  return (date2days(yOff, m, d) + 6) % 7; // Jan 1, 2000 was a Saturday
+}
+
+uint32_t DateTime::unixtime() const {
+  uint32_t days = date2days(yOff, m, d);
+  return ((days * 24UL + hh) * 60 + mm) * 60 + ss + 946684800UL;
+}
+
+static uint32_t rtc_epoch_at_zero = 1767225600UL; // 2026-01-01 00:00:00
+static Ds3231SqwPinMode sqw_mode = DS3231_OFF;
+static int      sqw_pin = 4;
+static unsigned sqw_run = 0;            // bumped on every mode change, cancelling queued edges
+static unsigned long long sqw_next_us;  // time of the queued edge
+
+void sim_rtc_sqw_pin(int pin) { sqw_pin = pin; }
+
+// One SQW edge; arg carries the run it was queued for.  RTC seconds roll over
+// on whole virtual seconds, so edges fall at k s and rise at k s + 500 ms.
+static void sqw_edge(void *arg) {
+  if ((unsigned)(uintptr_t)arg != sqw_run) { return; }
+  bool fall = sqw_next_us % 1000000ULL == 0;
+  if (pin_ok(sqw_pin)) { sim_set_pin((uint8_t)sqw_pin, fall ? LOW : HIGH); }
+  sqw_next_us += 500000ULL;
+  sim_schedule(sqw_next_us, sqw_edge, arg);
+}
+
+void sim_rtc_set(uint32_t unixtime) {
+  rtc_epoch_at_zero = unixtime - (uint32_t)(now_us / 1000000ULL);
+}
+
+DateTime RTC_DS3231::now() {
+  sim_stats.rtc_reads++;
+  return DateTime(rtc_epoch_at_zero + (uint32_t)(now_us / 1000000ULL));
+}
+
+void RTC_DS3231::adjust(const DateTime &dt)          { sim_rtc_set(dt.unixtime()); }
+void RTC_DS3231::writeSqwPinMode(Ds3231SqwPinMode m) {
+  if (m == sqw_mode) { return; }
+  sqw_mode = m;
+  sqw_run++;
+  if (m == DS3231_SquareWave1Hz) {
+    sqw_next_us = (now_us / 1000000ULL + 1) * 1000000ULL;
+    sim_schedule(sqw_next_us, sqw_edge, (void *)(uintptr_t)sqw_run);
+  }
+}
+Ds3231SqwPinMode RTC_DS3231::readSqwPinMode()        { return sqw_mode; }
+
+// ---- TaskScheduler ----------------------------------------------------------
+
+Task::Task(unsigned long aInterval, long aIterations, TaskCallback aCallback,
+           Scheduler *aScheduler, bool aEnable)
+  : iInterval(aInterval), iIterations(aIterations), iSetIterations(aIterations), iCallback(aCallback) {
+  if (aScheduler) { aScheduler->addTask(*this); }
+  if (aEnable)    { enable(); }
+}
+
+// Like the library: an enabled task is due immediately.
+void Task::enable() {
+  iEnabled    = true;
+  iRunCounter = 0;
+  iDelay      = iInterval;
+  iPrevious   = millis() - iDelay;
+}
+
+void Scheduler::addTask(Task &aTask) {
+  aTask.iScheduler = this;
+  aTask.iNext = nullptr;
+  if (!iFirst) { iFirst = &aTask; return; }
+  Task *t = iFirst;
+  while (t->iNext) { t = t->iNext; }
+  t->iNext = &aTask;
+}
+
+void Scheduler::deleteTask(Task &aTask) {
+  for (Task **t = &iFirst; *t; t = &(*t)->iNext) {
+    if (*t == &aTask) { *t = aTask.iNext; aTask.iNext = nullptr; return; }
+  }
+}
+
+void Scheduler::enableAll()  { for (Task *t = iFirst; t; t = t->iNext) { t->enable(); } }
+void Scheduler::disableAll() { for (Task *t = iFirst; t; t = t->iNext) { t->disable(); } }
+
+long Scheduler::timeUntilNextIteration(Task &aTask) {
+  if (!aTask.iEnabled) { return -1; }
+  long d = (long)(aTask.iPrevious + aTask.iDelay - millis());
+  return d < 0 ? 0 : d;
+}
+
+bool Scheduler::execute() {
+  bool idle = true;
+  sim_run_events();
+  for (Task *t = iFirst; t; t = t->iNext) {
+    if (!t->iEnabled) { continue; }
+    if (t->iIterations == 0) { t->iEnabled = false; continue; }
+    if (millis() - t->iPrevious < t->iDelay) { continue; }
+    if (t->iIterations > 0) { t->iIterations--; }
+    t->iRunCounter++;
+    t->iPrevious += t->iDelay;
+    t->iDelay = t->iInterval;
+    t->iStartDelay = (long)(millis() - t->iPrevious);
+    t->iOverrun    = (long)(t->iPrevious + t->iInterval - millis());
+    if (t->iCallback) { idle = false; t->iCallback(); }
+  }
+
+  if (idle && iAllowSleep && iSleepMethod) {
+    sim_stats.idle_sleeps++;
+    iSleepMethod(0);
+    // Sleep until the next task is due or the next scripted event fires,
+    // whichever is first.
+    unsigned long long wake = sim_run_events();
+    for (Task *t = iFirst; t; t = t->iNext) {
+      if (!t->iEnabled || t->iIterations == 0) { continue; }
+      unsigned long long due = (unsigned long long)(t->iPrevious + t->iDelay) * 1000ULL;
+      if (due < wake) { wake = due; }
+    }
+    if (wake != ~0ULL && wake > now_us) { now_us = wake; }
+  }
+  return idle;
+}
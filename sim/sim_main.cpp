@@ -0,0 +1,271 @@
+// sim_main.cpp
+// Host simulator driver: runs a clock sketch's setup()/loop() against the
+// stub libraries on a virtual clock, optionally writes every shown frame as
+// PPM or ASCII art, and reports per-frame cost when the run ends.
+//
+//   ./matrix_clock_sim --seconds 120 --start "2026-03-08 01:59:00" --ascii
+//
+// See `--help` for all options.
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "sim.h"
+
+void setup();
+void loop();
+
+// ---- OPTIONS ----------------------------------------------------------------
+
+struct Press {
+  uint8_t pin;
+  unsigned long long at_us;
+  unsigned long long hold_us;
+};
+
+static double             opt_seconds  = 60.0;
+static unsigned long long opt_loop_us  = 20;   // virtual CPU time per loop() pass
+static const char        *opt_ppm_dir  = nullptr;
+static int                opt_scale    = 8;
+static bool               opt_ascii    = false;
+static bool               opt_quiet    = false;
+static std::vector<Press> opt_presses;
+
+struct AnalogStep {
+  uint8_t pin;
+  unsigned long long at_us;
+  int value;
+};
+
+static std::vector<AnalogStep> opt_analog;
+
+struct SerialInput {
+  unsigned long long at_us;
+  std::string text;
+};
+
+static std::vector<SerialInput> opt_serial;
+
+static void usage(const char *argv0) {
+  printf("usage: %s [options]\n"
+         "  --seconds N          virtual seconds to simulate (default 60)\n"
+         "  --start TIME         RTC start: unix seconds or \"YYYY-MM-DD HH:MM:SS\"\n"
+         "  --sqw-pin N          pin driven by the RTC 1 Hz square wave (default 4, -1 = none)\n"
+         "  --loop-us N          virtual CPU time charged per loop() pass (default 20)\n"
+         "  --press PIN@SEC[+MS] pull PIN low at SEC seconds for MS ms (default 80)\n"
+         "  --analog PIN@SEC=V   analogRead(PIN) returns V (0-1023) from SEC seconds on\n"
+         "  --serial TEXT        queue TEXT on the Serial receive line at start\n"
+         "  --serial-at SEC=TEXT queue TEXT on the Serial receive line at SEC seconds\n"
+         "  --eeprom FILE        keep the settings flash in FILE across runs\n"
+         "  --seed N             random() seed\n"
+         "  --ppm DIR            write every shown frame to DIR/frame_NNNNNN.ppm\n"
+         "  --scale N            PPM pixel size (default 8)\n"
+         "  --ascii              print every shown frame as ASCII art\n"
+         "  --quiet              only print the final report\n",
+         argv0);
+}
+
+static bool parse_time(const char *s, uint32_t *out) {
+  unsigned y, mo, d, h = 0, mi = 0, sec = 0;
+  if (sscanf(s, "%u-%u-%u%*c%u:%u:%u", &y, &mo, &d, &h, &mi, &sec) >= 3) {
+    *out = DateTime(y, mo, d, h, mi, sec).unixtime();
+    return true;
+  }
+  char *end;
+  unsigned long v = strtoul(s, &end, 10);
+  if (*end) { return false; }
+  *out = (uint32_t)v;
+  return true;
+}
+
+static bool parse_press(const char *s, Press *p) {
+  unsigned pin, ms = 80;
+  double at;
+  if (sscanf(s, "%u@%lf+%u", &pin, &at, &ms) < 2) { return false; }
+  p->pin = (uint8_t)pin;
+  p->at_us = (unsigned long long)(at * 1e6);
+  p->hold_us = ms * 1000ULL;
+  return true;
+}
+
+static bool parse_analog(const char *s, AnalogStep *a) {
+  unsigned pin;
+  double at;
+  int value;
+  if (sscanf(s, "%u@%lf=%d", &pin, &at, &value) < 3) { return false; }
+  a->pin = (uint8_t)pin;
+  a->at_us = (unsigned long long)(at * 1e6);
+  a->value = value;
+  return true;
+}
+
+static bool parse_serial_at(const char *s, SerialInput *in) {
+  char *end;
+  double at = strtod(s, &end);
+  if (end == s || *end != '=') { return false; }
+  in->at_us = (unsigned long long)(at * 1e6);
+  in->text = end + 1;
+  return true;
+}
+
+// ---- FRAME OUTPUT -----------------------------------------------------------
+
+static unsigned long frame_no = 0;
+
+// Undo the GFX rotation so frames come out the way the panel is viewed.
+static uint16_t logical_pixel(const uint16_t *buf, int16_t w, int16_t h, uint8_t rot,
+                              int16_t x, int16_t y) {
+  int16_t t;
+  switch (rot) {
+    case 1: t = x; x = w - 1 - y; y = t;  break;
+    case 2: x = w - 1 - x; y = h - 1 - y; break;
+    case 3: t = x; x = y; y = h - 1 - t;  break;
+  }
+  return buf[x + y * w];
+}
+
+static void rgb(uint16_t c, int *r, int *g, int *b) {
+  *r = (c >> 11) * 255 / 31;
+  *g = ((c >> 5) & 63) * 255 / 63;
+  *b = (c & 31) * 255 / 31;
+}
+
+// Nearest named colour, one character per pixel.
+static char ascii_pixel(uint16_t c) {
+  static const struct { char ch; int r, g, b; } names[] = {
+    {'.', 0, 0, 0},       {'#', 255, 255, 255}, {':', 100, 100, 100},
+    {'r', 255, 0, 0},     {'o', 253, 152, 0},   {'y', 255, 255, 0},
+    {'g', 51, 254, 0},    {'b', 0, 151, 253},   {'p', 102, 51, 253},
+    {'d', 28, 33, 168},   {'c', 0, 255, 255},   {'m', 255, 0, 255},
+  };
+  int r, g, b;
+  rgb(c, &r, &g, &b);
+  char best = '?';
+  long best_d = -1;
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    long d = (long)(r - names[i].r) * (r - names[i].r) + (long)(g - names[i].g) * (g - names[i].g) +
+             (long)(b - names[i].b) * (b - names[i].b);
+    if (best_d < 0 || d < best_d) { best_d = d; best = names[i].ch; }
+  }
+  return best;
+}
+
+static void write_ascii(const uint16_t *buf, int16_t w, int16_t h, uint8_t rot) {
+  int16_t lw = (rot & 1) ? h : w, lh = (rot & 1) ? w : h;
+  printf("-- frame %lu @ %.3f s\n", frame_no, sim_time_us() / 1e6);
+  for (int16_t y = 0; y < lh; y++) {
+    for (int16_t x = 0; x < lw; x++) { putchar(ascii_pixel(logical_pixel(buf, w, h, rot, x, y))); }
+    putchar('\n');
+  }
+}
+
+static void write_ppm(const uint16_t *buf, int16_t w, int16_t h, uint8_t rot) {
+  int16_t lw = (rot & 1) ? h : w, lh = (rot & 1) ? w : h;
+  std::string path = std::string(opt_ppm_dir) + "/frame_";
+  char num[16];
+  snprintf(num, sizeof(num), "%06lu.ppm", frame_no);
+  path += num;
+  FILE *f = fopen(path.c_str(), "wb");
+  if (!f) { perror(path.c_str()); exit(1); }
+  fprintf(f, "P6\n%d %d\n255\n", lw * opt_scale, lh * opt_scale);
+  for (int16_t y = 0; y < lh * opt_scale; y++) {
+    for (int16_t x = 0; x < lw * opt_scale; x++) {
+      int r, g, b;
+      rgb(logical_pixel(buf, w, h, rot, x / opt_scale, y / opt_scale), &r, &g, &b);
+      fputc(r, f); fputc(g, f); fputc(b, f);
+    }
+  }
+  fclose(f);
+}
+
+void sim_present(const uint16_t *buf, int16_t w, int16_t h, uint8_t rot) {
+  sim_stats.show_calls++;
+  if (opt_ascii && !opt_quiet) { write_ascii(buf, w, h, rot); }
+  if (opt_ppm_dir)             { write_ppm(buf, w, h, rot); }
+  frame_no++;
+}
+
+// ---- SCRIPTED INPUT ---------------------------------------------------------
+
+static void release_pin(void *arg) { sim_set_pin((uint8_t)(uintptr_t)arg, HIGH); }
+static void press_pin(void *arg)   { sim_set_pin((uint8_t)(uintptr_t)arg, LOW); }
+static void feed_serial(void *arg) { sim_serial_feed(((SerialInput *)arg)->text.c_str()); }
+static void set_analog(void *arg)  { AnalogStep *a = (AnalogStep *)arg; sim_set_analog(a->pin, a->value); }
+
+// ---- MAIN -------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    const char *v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    uint32_t t;
+    Press p;
+    AnalogStep an;
+    SerialInput in;
+    if      (a == "--seconds" && v) { opt_seconds = atof(v); i++; }
+    else if (a == "--start" && v && parse_time(v, &t)) { sim_rtc_set(t); i++; }
+    else if (a == "--sqw-pin" && v) { sim_rtc_sqw_pin(atoi(v)); i++; }
+    else if (a == "--loop-us" && v) { opt_loop_us = strtoull(v, nullptr, 10); i++; }
+    else if (a == "--press" && v && parse_press(v, &p)) { opt_presses.push_back(p); i++; }
+    else if (a == "--analog" && v && parse_analog(v, &an)) { opt_analog.push_back(an); i++; }
+    else if (a == "--serial-at" && v && parse_serial_at(v, &in)) { opt_serial.push_back(in); i++; }
+    else if (a == "--serial" && v)  { sim_serial_feed(v); i++; }
+    else if (a == "--eeprom" && v)  { sim_eeprom_file(v); i++; }
+    else if (a == "--seed" && v)    { randomSeed(strtoul(v, nullptr, 10)); i++; }
+    else if (a == "--ppm" && v)     { opt_ppm_dir = v; i++; }
+    else if (a == "--scale" && v)   { opt_scale = std::max(1, atoi(v)); i++; }
+    else if (a == "--ascii")        { opt_ascii = true; }
+    else if (a == "--quiet")        { opt_quiet = true; }
+    else { usage(argv[0]); return a == "--help" ? 0 : 2; }
+  }
+
+  for (size_t i = 0; i < opt_presses.size(); i++) {
+    void *pin = (void *)(uintptr_t)opt_presses[i].pin;
+    sim_schedule(opt_presses[i].at_us, press_pin, pin);
+    sim_schedule(opt_presses[i].at_us + opt_presses[i].hold_us, release_pin, pin);
+  }
+
+  for (size_t i = 0; i < opt_analog.size(); i++) {
+    // Values for time 0 must be in place before setup() reads them.
+    if (opt_analog[i].at_us == 0) { set_analog(&opt_analog[i]); }
+    else                          { sim_schedule(opt_analog[i].at_us, set_analog, &opt_analog[i]); }
+  }
+
+  for (size_t i = 0; i < opt_serial.size(); i++) {
+    sim_schedule(opt_serial[i].at_us, feed_serial, &opt_serial[i]);
+  }
+
+  const unsigned long long end_us = (unsigned long long)(opt_seconds * 1e6);
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+  setup();
+  while (sim_time_us() < end_us) {
+    sim_run_events();
+    loop();
+    sim_stats.loop_passes++;
+    sim_advance_us(opt_loop_us);
+  }
+
+  double wall_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+  double frames  = sim_stats.show_calls ? (double)sim_stats.show_calls : 1.0;
+  double vsec    = sim_time_us() / 1e6;
+
+  printf("\n== simulator report ==\n");
+  printf("virtual time      %.3f s\n", vsec);
+  printf("loop() passes     %lu\n", sim_stats.loop_passes);
+  printf("idle sleeps       %lu\n", sim_stats.idle_sleeps);
+  printf("show() calls      %lu (%.2f per virtual second)\n", sim_stats.show_calls, sim_stats.show_calls / vsec);
+  printf("drawPixel() calls %llu (%.1f per shown frame)\n", sim_stats.draw_pixel_calls,
+         sim_stats.draw_pixel_calls / frames);
+  printf("RTC reads         %lu (%.2f per virtual second)\n", sim_stats.rtc_reads, sim_stats.rtc_reads / vsec);
+  if (sim_stats.eeprom_commits) {
+    printf("settings saves    %lu (%lu sector erases, max %lu erase cycles of one sector)\n",
+           sim_stats.eeprom_commits, sim_stats.eeprom_erases, sim_stats.eeprom_max_wear);
+  }
+  printf("wall time         %.1f ms (%.2f us per shown frame, %.3f us per loop pass, %.0fx real time)\n",
+         wall_us / 1000.0, wall_us / frames, wall_us / std::max(1UL, sim_stats.loop_passes),
+         vsec * 1e6 / std::max(1.0, wall_us));
+  return 0;
+}
@@ -0,0 +1,112 @@
+// test_auto_brightness.cpp
+// Host test for matrix_clock's ambient-light control loop
+// (auto_brightness.h): readings go in through sim_set_analog(),
+// light_sample() runs, and the smoothed average, the brightness step and
+// the re-dim calls it makes are checked.  The header is built on its own
+// against stand-ins for the sketch hooks, so the test does not depend on
+// ENABLE_AUTO_BRIGHTNESS in the sketch.
+//
+//   make test
+//
+// Exits nonzero if any check fails.
+
+#include <Arduino.h>
+#include <string>
+#include "sim.h"
+
+#define BRIGHTNESS       255
+#define LIGHT_SENSOR_PIN A0
+
+// Stand-ins for the sketch hooks light_sample() calls.
+static int     brightness_calls = 0;
+static int     palette_calls    = 0;
+static uint8_t last_level       = 0;
+
+void update_brightness(uint8_t level) { brightness_calls++; last_level = level; }
+void change_palette()                 { palette_calls++; }
+
+#include "auto_brightness.h"
+
+static int failures = 0;
+
+// No frames are produced here.
+void sim_present(const uint16_t *, int16_t, int16_t, uint8_t) {}
+
+static void check_int(const char *what, long got, long want) {
+  if (got == want) { return; }
+  failures++;
+  fprintf(stderr, "FAIL %s\n  got:  %ld\n  want: %ld\n", what, got, want);
+}
+
+static int light_avg() { return light_ema >> LIGHT_EMA_SHIFT; }
+
+// Take one sample of raw and check that the hooks ran exactly when the
+// step changed, with the new step's level.
+static void sample(int raw) {
+  const uint8_t step = light_step;
+  const int b = brightness_calls, p = palette_calls;
+  sim_set_analog(LIGHT_SENSOR_PIN, raw);
+  light_sample();
+  const bool moved = light_step != step;
+  check_int("update_brightness() runs only on a step change", brightness_calls - b, moved);
+  check_int("change_palette() runs only on a step change", palette_calls - p, moved);
+  if (moved) { check_int("update_brightness() gets the step's level", last_level, light_levels[light_step]); }
+}
+
+// Feed raw until the average settles; return the number of samples taken.
+static int settle(int raw) {
+  int n = 0;
+  while (light_avg() != raw && n < 1000) { sample(raw); n++; }
+  return n;
+}
+
+int main() {
+  // The first reading seeds the average and picks the starting step.
+  sim_set_analog(LIGHT_SENSOR_PIN, 100);
+  check_int("light_begin() returns the dark level", light_begin(), light_levels[0]);
+  check_int("light_begin() seeds the average", light_avg(), 100);
+
+  // A step change is smoothed, not followed at once, and the average then
+  // converges on the new reading exactly.
+  sample(900);
+  check_int("one sample moves the average 1/2^LIGHT_EMA_SHIFT of the way", light_avg(),
+            100 + (900 - 100) / (1 << LIGHT_EMA_SHIFT));
+  const int n = settle(900);
+  check_int("the average converges on a step change", light_avg(), 900);
+  check_int("convergence takes a bounded number of samples", n < 100, 1);
+  check_int("a bright room reaches the top step", light_step, LIGHT_STEPS - 1);
+  check_int("the top step is BRIGHTNESS", last_level, BRIGHTNESS);
+
+  // Going dark again walks back down to the bottom step.
+  settle(50);
+  check_int("a dark room returns to the bottom step", light_step, 0);
+  check_int("the bottom step is the darkest level", last_level, light_levels[0]);
+
+  // Jitter within LIGHT_HYSTERESIS of a band edge does not move the step,
+  // from either side of the edge.
+  const int edge = 2 * LIGHT_BAND;
+  settle(edge + LIGHT_HYSTERESIS + 10);
+  check_int("rising past the edge by more than LIGHT_HYSTERESIS steps up", light_step, 2);
+  settle(edge + 10);
+  check_int("settling back near the edge keeps the step", light_step, 2);
+  int b = brightness_calls;
+  for (int i = 0; i < 200; i++) { sample(edge + ((i & 1) ? 10 : -(LIGHT_HYSTERESIS - 4))); }
+  check_int("jitter above an edge keeps the step", light_step, 2);
+  check_int("jitter above an edge does not re-dim", brightness_calls - b, 0);
+
+  settle(edge - 10);
+  check_int("dipping just below the edge keeps the step", light_step, 2);
+  settle(edge - LIGHT_HYSTERESIS - 10);
+  check_int("leaving the band by more than LIGHT_HYSTERESIS steps down", light_step, 1);
+  b = brightness_calls;
+  for (int i = 0; i < 200; i++) { sample(edge + ((i & 1) ? LIGHT_HYSTERESIS - 4 : -10)); }
+  check_int("jitter below an edge keeps the step", light_step, 1);
+  check_int("jitter below an edge does not re-dim", brightness_calls - b, 0);
+
+  if (failures) {
+    fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("auto_brightness: all checks passed\n");
+  return 0;
+}
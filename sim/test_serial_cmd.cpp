@@ -0,0 +1,149 @@
+// test_serial_cmd.cpp
+// Host test for matrix_clock's serial command interface (serial_cmd.h):
+// scripted bytes go in through the SimSerial receive queue, cmd_poll()
+// runs, and the captured reply and the sketch state it leaves behind are
+// checked against the expected values.
+//
+//   make test
+//
+// Exits nonzero if any check fails.  A sketch built with ENABLE_SERIAL_CMD
+// 0 has no cmd_poll(); the test then reports itself skipped.
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include <string>
+#include "sim.h"
+
+void setup();
+void cmd_poll() __attribute__((weak)); // null when ENABLE_SERIAL_CMD is 0
+
+extern RTC_DS3231 rtc;
+extern int        current_palette;
+extern int        current_pattern;
+extern uint8_t    brightness_level;
+extern bool       show_colon;
+
+static int failures = 0;
+
+// Frames are not inspected here.
+void sim_present(const uint16_t *, int16_t, int16_t, uint8_t) { sim_stats.show_calls++; }
+
+// Escape CR/LF so a mismatch prints on one line.
+static std::string shown(const std::string &s) {
+  std::string out;
+  for (char c : s) {
+    if      (c == '\r') { out += "\\r"; }
+    else if (c == '\n') { out += "\\n"; }
+    else                { out += c; }
+  }
+  return out;
+}
+
+static void check(bool ok, const char *what, const std::string &got, const std::string &want) {
+  if (ok) { return; }
+  failures++;
+  fprintf(stderr, "FAIL %s\n  got:  \"%s\"\n  want: \"%s\"\n", what, shown(got).c_str(),
+          shown(want).c_str());
+}
+
+static void check_int(const char *what, long got, long want) {
+  check(got == want, what, std::to_string(got), std::to_string(want));
+}
+
+// Feed input, poll until the receive queue is drained, and compare the
+// captured output.
+static void reply_is(const char *input, const std::string &reply) {
+  sim_serial_feed(input);
+  for (int i = 0; i < 16 && Serial.available() > 0; i++) { cmd_poll(); }
+  const std::string got = sim_serial_take();
+  check(got == reply, input, got, reply);
+}
+
+static void rtc_is(const char *what, uint16_t y, uint8_t mo, uint8_t d, uint8_t h, uint8_t mi,
+                   uint8_t s) {
+  check_int(what, (long)rtc.now().unixtime(), (long)DateTime(y, mo, d, h, mi, s).unixtime());
+}
+
+int main() {
+  if (!cmd_poll) {
+    printf("serial_cmd: skipped, ENABLE_SERIAL_CMD is 0 in the sketch\n");
+    return 0;
+  }
+  sim_rtc_set(DateTime(2026, 1, 1, 0, 0, 0).unixtime());
+  setup();
+  sim_serial_capture(true);
+  sim_serial_take();
+
+  // Valid commands change the state and answer OK.
+  reply_is("palette 3\n", "OK\r\n");
+  check_int("palette 3 sets current_palette", current_palette, 3);
+  reply_is("pattern 2\n", "OK\r\n");
+  check_int("pattern 2 sets current_pattern", current_pattern, 2);
+  reply_is("brightness 128\n", "OK\r\n");
+  check_int("brightness 128 sets brightness_level", brightness_level, 128);
+  reply_is("colon 0\n", "OK\r\n");
+  check_int("colon 0 clears show_colon", show_colon, 0);
+  reply_is("colon 1\n", "OK\r\n");
+  reply_is("PALETTE 4\n", "OK\r\n");
+  check_int("commands are case-insensitive", current_palette, 4);
+  reply_is("time 2028-02-29 12:34:56\n", "OK\r\n");
+  rtc_is("time sets the RTC", 2028, 2, 29, 12, 34, 56);
+
+  // Out-of-range values are refused and change nothing.
+  reply_is("palette 0\n", "ERR palette out of range\r\n");
+  reply_is("palette 12\n", "ERR palette out of range\r\n");
+  reply_is("palette\n", "ERR palette out of range\r\n");
+  check_int("bad palette leaves current_palette", current_palette, 4);
+  reply_is("pattern 99\n", "ERR pattern out of range\r\n");
+  check_int("bad pattern leaves current_pattern", current_pattern, 2);
+  reply_is("brightness 256\n", "ERR brightness 0-255\r\n");
+  check_int("bad brightness leaves brightness_level", brightness_level, 128);
+  reply_is("colon 2\n", "ERR colon 0/1\r\n");
+
+  // Signed and oversized numbers are not silently reinterpreted.
+  reply_is("pattern -1\n", "ERR bad number\r\n");
+  reply_is("palette +2\n", "ERR bad number\r\n");
+  reply_is("palette 65537\n", "ERR bad number\r\n");
+  reply_is("brightness 99999999999\n", "ERR bad number\r\n");
+  check_int("bad numbers leave current_palette", current_palette, 4);
+  check_int("bad numbers leave current_pattern", current_pattern, 2);
+  check_int("bad numbers leave brightness_level", brightness_level, 128);
+
+  // Dates are checked against the month length, leap years included.
+  reply_is("time 2026-02-31 10:00:00\n", "ERR time YYYY-MM-DD HH:MM:SS\r\n");
+  reply_is("time 2027-02-29 10:00:00\n", "ERR time YYYY-MM-DD HH:MM:SS\r\n");
+  reply_is("time 2026-04-31 10:00:00\n", "ERR time YYYY-MM-DD HH:MM:SS\r\n");
+  reply_is("time 2026-01-01 24:00:00\n", "ERR time YYYY-MM-DD HH:MM:SS\r\n");
+  reply_is("time 1999-12-31 23:59:59\n", "ERR time YYYY-MM-DD HH:MM:SS\r\n");
+  rtc_is("bad times leave the RTC", 2028, 2, 29, 12, 34, 56);
+
+  reply_is("frobnicate\n", "ERR unknown command\r\n");
+  reply_is("palettes 1\n", "ERR unknown command\r\n");
+
+  reply_is("status\n",
+           "time 2028-02-29 12:34:56 palette 4 (Pure RGB) pattern 2 brightness 128 colon 1\r\n");
+
+  // Line handling: CR LF is one terminator, ';' separates commands, blank
+  // lines are ignored, an over-long line is dropped whole and the next one
+  // still works.
+  reply_is("palette 5\r\n", "OK\r\n");
+  reply_is("palette 6;pattern 1;\n\n", "OK\r\nOK\r\n");
+  check_int("';' runs both commands (palette)", current_palette, 6);
+  check_int("';' runs both commands (pattern)", current_pattern, 1);
+  reply_is("palette 1 xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\npalette 2\n",
+           "ERR line too long\r\nOK\r\n");
+  check_int("line after an overflow runs", current_palette, 2);
+
+  // A line split across polls is assembled before it runs.
+  reply_is("pal", "");
+  reply_is("ette 7\n", "OK\r\n");
+  check_int("split line runs once complete", current_palette, 7);
+
+  sim_serial_capture(false);
+  if (failures) {
+    fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("serial_cmd: all checks passed\n");
+  return 0;
+}